@@ -0,0 +1,193 @@
+#ifndef BITSETADJACENCY_HPP
+#define BITSETADJACENCY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BITSET_ADJACENCY_X86
+#endif
+
+// Dense adjacency matrix with one bit per vertex pair (black and red edges alike).
+// The symmetric difference of two neighbourhoods becomes XOR + popcount over the two rows.
+// Rows are padded to 512 bits so every SIMD path runs without a scalar tail.
+// Every live matrix draws its bytes from one process-wide budget, so concurrent components,
+// portfolio runs and the lower bound cannot add up past it. A matrix that does not get its
+// bytes stays empty and the caller scores on adjacency lists instead.
+class BitsetAdjacency {
+public:
+    static constexpr int MAX_VERTICES = 1 << 16;
+    static constexpr std::size_t MAX_BYTES = std::size_t(256) << 20; // one matrix
+    static constexpr std::size_t BUDGET_BYTES = std::size_t(1) << 30; // all matrices alive at once
+
+    static std::size_t rowWords(int n) {
+        return ((static_cast<std::size_t>(n) + 511) / 512) * 8;
+    }
+
+    static std::size_t bytesFor(int n) {
+        return static_cast<std::size_t>(n) * rowWords(n) * sizeof(std::uint64_t);
+    }
+
+    static bool fits(int n) {
+        return n <= MAX_VERTICES && bytesFor(n) <= MAX_BYTES;
+    }
+
+    BitsetAdjacency() = default;
+
+    // A copy takes its own share of the budget and comes out empty when there is none left
+    BitsetAdjacency(const BitsetAdjacency& other) {
+        if (other.reservedBytes == 0 || !reserve(other.reservedBytes)) return;
+        reservedBytes = other.reservedBytes;
+        stride = other.stride;
+        bits = other.bits;
+    }
+
+    BitsetAdjacency(BitsetAdjacency&& other) noexcept
+        : bits(std::move(other.bits)), stride(other.stride), reservedBytes(other.reservedBytes) {
+        other.stride = 0;
+        other.reservedBytes = 0;
+    }
+
+    BitsetAdjacency& operator=(BitsetAdjacency other) noexcept {
+        std::swap(bits, other.bits);
+        std::swap(stride, other.stride);
+        std::swap(reservedBytes, other.reservedBytes);
+        return *this;
+    }
+
+    ~BitsetAdjacency() { release(); }
+
+    // An all-zero n x n matrix. False, and an empty matrix, when n does not fit or the
+    // process budget cannot cover it.
+    bool allocate(int n) {
+        release();
+        if (!fits(n) || !reserve(bytesFor(n))) return false;
+        reservedBytes = bytesFor(n);
+        stride = rowWords(n);
+        bits.assign(static_cast<std::size_t>(n) * stride, 0);
+        return true;
+    }
+
+    bool allocated() const { return reservedBytes != 0; }
+
+    // Frees the rows and hands their bytes back to the budget
+    void release() {
+        std::vector<std::uint64_t>().swap(bits);
+        stride = 0;
+        if (reservedBytes != 0) budgetUsed().fetch_sub(reservedBytes, std::memory_order_relaxed);
+        reservedBytes = 0;
+    }
+
+    bool hasEdge(int u, int v) const {
+        return (row(u)[v >> 6] >> (v & 63)) & 1;
+    }
+
+    void addEdge(int u, int v) {
+        row(u)[v >> 6] |= std::uint64_t(1) << (v & 63);
+        row(v)[u >> 6] |= std::uint64_t(1) << (u & 63);
+    }
+
+    void removeEdge(int u, int v) {
+        row(u)[v >> 6] &= ~(std::uint64_t(1) << (v & 63));
+        row(v)[u >> 6] &= ~(std::uint64_t(1) << (u & 63));
+    }
+
+    // |N(u) Δ N(v)| without u and v themselves. There are no self loops, so
+    // u and v only show up in the XOR when they are adjacent, once each.
+    int symmetricDifference(int u, int v) const {
+        int count = static_cast<int>(xorPopcount()(row(u), row(v), stride));
+        return hasEdge(u, v) ? count - 2 : count;
+    }
+
+private:
+    using XorPopcountFn = std::uint64_t (*)(const std::uint64_t*, const std::uint64_t*, std::size_t);
+
+    std::vector<std::uint64_t> bits;
+    std::size_t stride = 0;
+    std::size_t reservedBytes = 0; // taken from the budget, 0 while empty
+
+    static std::atomic<std::size_t>& budgetUsed() {
+        static std::atomic<std::size_t> used{0};
+        return used;
+    }
+
+    static bool reserve(std::size_t bytes) {
+        std::size_t used = budgetUsed().load(std::memory_order_relaxed);
+        do {
+            if (bytes > BUDGET_BYTES - used) return false;
+        } while (!budgetUsed().compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+        return true;
+    }
+
+    std::uint64_t* row(int v) { return bits.data() + static_cast<std::size_t>(v) * stride; }
+    const std::uint64_t* row(int v) const { return bits.data() + static_cast<std::size_t>(v) * stride; }
+
+    static std::uint64_t xorPopcountScalar(const std::uint64_t* a, const std::uint64_t* b, std::size_t words) {
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < words; ++i) count += __builtin_popcountll(a[i] ^ b[i]);
+        return count;
+    }
+
+#ifdef BITSET_ADJACENCY_X86
+    __attribute__((target("popcnt")))
+    static std::uint64_t xorPopcountPopcnt(const std::uint64_t* a, const std::uint64_t* b, std::size_t words) {
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < words; ++i) count += __builtin_popcountll(a[i] ^ b[i]);
+        return count;
+    }
+
+    // Nibble lookup popcount (Mula), bytes summed into 64-bit lanes with SAD
+    __attribute__((target("avx2")))
+    static std::uint64_t xorPopcountAvx2(const std::uint64_t* a, const std::uint64_t* b, std::size_t words) {
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i lowMask = _mm256_set1_epi8(0x0f);
+        __m256i total = _mm256_setzero_si256();
+        for (std::size_t i = 0; i < words; i += 4) {
+            __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+            __m256i low = _mm256_and_si256(x, lowMask);
+            __m256i high = _mm256_and_si256(_mm256_srli_epi16(x, 4), lowMask);
+            __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+        }
+        return static_cast<std::uint64_t>(_mm256_extract_epi64(total, 0)) + _mm256_extract_epi64(total, 1)
+             + _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+    }
+
+    __attribute__((target("avx512f,avx512vpopcntdq")))
+    static std::uint64_t xorPopcountAvx512(const std::uint64_t* a, const std::uint64_t* b, std::size_t words) {
+        __m512i total = _mm512_setzero_si512();
+        for (std::size_t i = 0; i < words; i += 8) {
+            __m512i x = _mm512_xor_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+            total = _mm512_add_epi64(total, _mm512_popcnt_epi64(x));
+        }
+        // Sum the lanes through memory: GCC's _mm512_reduce_add_epi64 trips -Wuninitialized
+        alignas(64) std::uint64_t lanes[8];
+        _mm512_store_si512(lanes, total);
+        std::uint64_t count = 0;
+        for (std::uint64_t lane : lanes) count += lane;
+        return count;
+    }
+#endif
+
+    // Picks the widest kernel the CPU supports, once per process
+    static XorPopcountFn xorPopcount() {
+        static const XorPopcountFn fn = [] {
+#ifdef BITSET_ADJACENCY_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")) return &xorPopcountAvx512;
+            if (__builtin_cpu_supports("avx2")) return &xorPopcountAvx2;
+            if (__builtin_cpu_supports("popcnt")) return &xorPopcountPopcnt;
+#endif
+            return &xorPopcountScalar;
+        }();
+        return fn;
+    }
+};
+
+#endif // BITSETADJACENCY_HPP
@@ -0,0 +1,197 @@
+#ifndef BUCKETQUEUE_HPP
+#define BUCKETQUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Vertices bucketed by an integer key (red degree, degree). Every bucket is an intrusive
+// doubly linked list threaded through per-vertex prev/next slots, so moving a vertex to
+// another bucket is O(1) and keeps the insertion order the old vector buckets had: the
+// vertex leaves its place and is appended at the tail of the new bucket.
+// A bitset of non-empty buckets keeps min/max tracking and getTopN off the empty ones.
+class BucketQueue {
+public:
+    static constexpr int NONE = -1;
+
+    // Forgets all vertices, vertex ids range over 0..numVertices-1
+    void reset(int numVertices) {
+        keyOf.assign(numVertices, NONE);
+        prev.assign(numVertices, NONE);
+        next.assign(numVertices, NONE);
+        head.clear();
+        tail.clear();
+        sizes.clear();
+        nonEmpty.clear();
+        minKeyCache = NONE;
+        maxKeyCache = NONE;
+        count = 0;
+    }
+
+    bool contains(int vertex) const {
+        return keyOf[vertex] != NONE;
+    }
+
+    int key(int vertex) const {
+        return keyOf[vertex];
+    }
+
+    // Appends vertex at the tail of bucket key, taking it out of its current bucket first
+    void push(int vertex, int key) {
+        if (contains(vertex)) erase(vertex);
+        if (static_cast<std::size_t>(key) >= head.size()) grow(key + 1);
+
+        keyOf[vertex] = key;
+        prev[vertex] = tail[key];
+        next[vertex] = NONE;
+        if (tail[key] != NONE) next[tail[key]] = vertex;
+        else head[key] = vertex;
+        tail[key] = vertex;
+
+        if (sizes[key]++ == 0) {
+            nonEmpty[key >> 6] |= std::uint64_t(1) << (key & 63);
+            if (minKeyCache == NONE || key < minKeyCache) minKeyCache = key;
+            if (key > maxKeyCache) maxKeyCache = key;
+        }
+        count++;
+    }
+
+    void erase(int vertex) {
+        int key = keyOf[vertex];
+        if (key == NONE) return;
+        if (prev[vertex] != NONE) next[prev[vertex]] = next[vertex];
+        else head[key] = next[vertex];
+        if (next[vertex] != NONE) prev[next[vertex]] = prev[vertex];
+        else tail[key] = prev[vertex];
+        keyOf[vertex] = prev[vertex] = next[vertex] = NONE;
+
+        if (--sizes[key] == 0) {
+            nonEmpty[key >> 6] &= ~(std::uint64_t(1) << (key & 63));
+            if (key == minKeyCache) minKeyCache = nextNonEmpty(key);
+            if (key == maxKeyCache) maxKeyCache = previousNonEmpty(key);
+        }
+        count--;
+    }
+
+    int size() const {
+        return count;
+    }
+
+    // Number of buckets ever used, keys range over 0..numKeys()-1
+    int numKeys() const {
+        return head.size();
+    }
+
+    int bucketSize(int key) const {
+        return key >= 0 && static_cast<std::size_t>(key) < sizes.size() ? sizes[key] : 0;
+    }
+
+    // Smallest / largest key of a non-empty bucket, NONE when there are no vertices
+    int minKey() const {
+        return minKeyCache;
+    }
+
+    int maxKey() const {
+        return maxKeyCache;
+    }
+
+    // Walk a bucket in insertion order: for (int v = first(k); v != NONE; v = after(v))
+    int first(int key) const {
+        return key >= 0 && static_cast<std::size_t>(key) < head.size() ? head[key] : NONE;
+    }
+
+    int after(int vertex) const {
+        return next[vertex];
+    }
+
+    int before(int vertex) const {
+        return prev[vertex];
+    }
+
+    // Undo support: puts vertex back into bucket key right behind predecessor (at the head
+    // for NONE), or takes it out when key is NONE. Replaying key()/before() recorded ahead of
+    // each change in reverse order restores every bucket exactly.
+    void restore(int vertex, int key, int predecessor) {
+        if (contains(vertex)) erase(vertex);
+        if (key == NONE) return;
+        if (predecessor == NONE && head[key] == NONE) {
+            push(vertex, key);
+            return;
+        }
+
+        keyOf[vertex] = key;
+        prev[vertex] = predecessor;
+        next[vertex] = predecessor != NONE ? next[predecessor] : head[key];
+        if (predecessor != NONE) next[predecessor] = vertex;
+        else head[key] = vertex;
+        if (next[vertex] != NONE) prev[next[vertex]] = vertex;
+        else tail[key] = vertex;
+        sizes[key]++;
+        count++;
+    }
+
+    // First n vertices going up from the smallest key, buckets in insertion order
+    std::vector<int> getTopNLowest(int n) const {
+        std::vector<int> topVertices;
+        std::size_t limit = n > 0 ? n : 0;
+        for (int key = minKeyCache; key != NONE && topVertices.size() < limit; key = nextNonEmpty(key)) {
+            for (int v = head[key]; v != NONE && topVertices.size() < limit; v = next[v]) topVertices.push_back(v);
+        }
+        return topVertices;
+    }
+
+    // First n vertices going down from the largest key, buckets in insertion order
+    std::vector<int> getTopNHighest(int n) const {
+        std::vector<int> topVertices;
+        std::size_t limit = n > 0 ? n : 0;
+        for (int key = maxKeyCache; key != NONE && topVertices.size() < limit; key = previousNonEmpty(key)) {
+            for (int v = head[key]; v != NONE && topVertices.size() < limit; v = next[v]) topVertices.push_back(v);
+        }
+        return topVertices;
+    }
+
+private:
+    std::vector<int> keyOf;
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<int> head;
+    std::vector<int> tail;
+    std::vector<int> sizes;
+    std::vector<std::uint64_t> nonEmpty;
+    int minKeyCache = NONE;
+    int maxKeyCache = NONE;
+    int count = 0;
+
+    void grow(int numKeys) {
+        head.resize(numKeys, NONE);
+        tail.resize(numKeys, NONE);
+        sizes.resize(numKeys, 0);
+        nonEmpty.resize((numKeys + 63) / 64, 0);
+    }
+
+    // Smallest non-empty key above key, NONE if there is none
+    int nextNonEmpty(int key) const {
+        std::size_t word = (key + 1) >> 6;
+        if (word >= nonEmpty.size()) return NONE;
+        std::uint64_t bits = nonEmpty[word] & (~std::uint64_t(0) << ((key + 1) & 63));
+        while (bits == 0) {
+            if (++word >= nonEmpty.size()) return NONE;
+            bits = nonEmpty[word];
+        }
+        return static_cast<int>(word << 6) + __builtin_ctzll(bits);
+    }
+
+    // Largest non-empty key below key, NONE if there is none
+    int previousNonEmpty(int key) const {
+        if (key <= 0) return NONE;
+        int word = (key - 1) >> 6;
+        std::uint64_t bits = nonEmpty[word] & (~std::uint64_t(0) >> (63 - ((key - 1) & 63)));
+        while (bits == 0) {
+            if (--word < 0) return NONE;
+            bits = nonEmpty[word];
+        }
+        return (word << 6) + 63 - __builtin_clzll(bits);
+    }
+};
+
+#endif // BUCKETQUEUE_HPP
@@ -0,0 +1,72 @@
+#ifndef COMPONENTSPLITTER_HPP
+#define COMPONENTSPLITTER_HPP
+
+#include <cstddef>
+#include <vector>
+#include "CsrAdjacency.hpp"
+
+// Connected components in one BFS pass, started from the vertices in index order, so
+// components are numbered by their smallest vertex. Inside a component the vertices keep
+// their relative order (localIndex is the rank among the component's vertices), which
+// turns a sorted row into a sorted relabelled row: every component's CSR is cut straight
+// out of the rows of the whole graph, without edge sets or id searches.
+class ComponentSplitter {
+public:
+    // forEachNeighbor(v, visit) calls visit(u) for every neighbour u of v
+    template <typename ForEachNeighbor>
+    ComponentSplitter(int n, ForEachNeighbor forEachNeighbor) : componentOf(n, -1), localIndex(n) {
+        std::vector<int> queue;
+        queue.reserve(n);
+        for (int s = 0; s < n; ++s) {
+            if (componentOf[s] != -1) continue;
+            int c = static_cast<int>(sizes.size());
+            sizes.push_back(0);
+            componentOf[s] = c;
+            queue.clear();
+            queue.push_back(s);
+            for (std::size_t head = 0; head < queue.size(); ++head) {
+                forEachNeighbor(queue[head], [&](int u) {
+                    if (componentOf[u] != -1) return;
+                    componentOf[u] = c;
+                    queue.push_back(u);
+                });
+            }
+        }
+        for (int v = 0; v < n; ++v) localIndex[v] = sizes[componentOf[v]]++;
+    }
+
+    int numComponents() const {
+        return static_cast<int>(sizes.size());
+    }
+
+    // Vertices of every component in increasing order, i.e. indexed by local index
+    std::vector<std::vector<int>> members() const {
+        std::vector<std::vector<int>> result(sizes.size());
+        for (std::size_t c = 0; c < sizes.size(); ++c) result[c].reserve(sizes[c]);
+        for (int v = 0; v < static_cast<int>(componentOf.size()); ++v) result[componentOf[v]].push_back(v);
+        return result;
+    }
+
+    // Adjacency of every component in local indices, forEachNeighbor has to visit in ascending order
+    template <typename ForEachNeighbor>
+    std::vector<CsrAdjacency> slices(ForEachNeighbor forEachNeighbor) const {
+        std::vector<CsrAdjacency> result(sizes.size());
+        for (std::size_t c = 0; c < sizes.size(); ++c) {
+            result[c].offsets.reserve(sizes[c] + 1);
+            result[c].offsets.push_back(0);
+        }
+        for (int v = 0; v < static_cast<int>(componentOf.size()); ++v) {
+            CsrAdjacency& csr = result[componentOf[v]];
+            forEachNeighbor(v, [&](int u) { csr.targets.push_back(localIndex[u]); });
+            csr.offsets.push_back(static_cast<int>(csr.targets.size()));
+        }
+        return result;
+    }
+
+private:
+    std::vector<int> componentOf;
+    std::vector<int> localIndex;
+    std::vector<int> sizes;
+};
+
+#endif // COMPONENTSPLITTER_HPP
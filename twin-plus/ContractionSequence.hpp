@@ -0,0 +1,85 @@
+#ifndef CONTRACTIONSEQUENCE_HPP
+#define CONTRACTIONSEQUENCE_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Contraction sequence of a component as packed (survivor, merged) records, vertices
+// already as printed (1-based input ids). Nothing is formatted until write(), which
+// renders the lines into a large buffer and hands it to the stream block by block.
+// The vertex left over after the last step is tracked instead of parsed back out.
+class ContractionSequence {
+public:
+    struct Step {
+        int survivor;
+        int merged;
+    };
+
+    static constexpr int NONE = -1;
+
+    void add(int survivor, int merged) {
+        steps.push_back({survivor, merged});
+    }
+
+    void append(const ContractionSequence& other) {
+        steps.insert(steps.end(), other.steps.begin(), other.steps.end());
+    }
+
+    void clear() {
+        steps.clear();
+    }
+
+    std::size_t size() const {
+        return steps.size();
+    }
+
+    bool empty() const {
+        return steps.empty();
+    }
+
+    const Step& operator[](std::size_t i) const {
+        return steps[i];
+    }
+
+    // Vertex that remains after all steps, NONE for an empty sequence
+    int survivor() const {
+        return steps.empty() ? NONE : steps.back().survivor;
+    }
+
+    // One "survivor merged" line per step
+    void write(std::ostream& out) const {
+        const std::size_t BLOCK_SIZE = std::size_t(1) << 20;
+        const std::size_t MAX_LINE = 24; // two ints, a space and a newline
+        std::vector<char> buffer(BLOCK_SIZE);
+        std::size_t used = 0;
+        for (const Step& step : steps) {
+            if (used + MAX_LINE > BLOCK_SIZE) {
+                out.write(buffer.data(), used);
+                used = 0;
+            }
+            used = appendInt(buffer.data(), used, step.survivor);
+            buffer[used++] = ' ';
+            used = appendInt(buffer.data(), used, step.merged);
+            buffer[used++] = '\n';
+        }
+        out.write(buffer.data(), used);
+    }
+
+private:
+    std::vector<Step> steps;
+
+    // value is a vertex id, never negative
+    static std::size_t appendInt(char* buffer, std::size_t used, int value) {
+        char digits[12];
+        int count = 0;
+        do {
+            digits[count++] = '0' + value % 10;
+            value /= 10;
+        } while (value != 0);
+        while (count > 0) buffer[used++] = digits[--count];
+        return used;
+    }
+};
+
+#endif // CONTRACTIONSEQUENCE_HPP
@@ -0,0 +1,99 @@
+#ifndef CSRADJACENCY_HPP
+#define CSRADJACENCY_HPP
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Compressed sparse row adjacency: the neighbours of v are
+// targets[offsets[v] .. offsets[v + 1]), sorted ascending.
+struct CsrAdjacency {
+    std::vector<int> offsets;
+    std::vector<int> targets;
+
+    int numVertices() const {
+        return offsets.empty() ? 0 : static_cast<int>(offsets.size()) - 1;
+    }
+
+    // Stores both directions of every undirected edge, self loops and duplicates are dropped
+    static CsrAdjacency fromEdges(int n, const std::vector<std::pair<int, int>>& edges) {
+        CsrAdjacency csr;
+        csr.offsets.assign(n + 1, 0);
+        for (const auto& [u, v] : edges) {
+            if (u == v) continue;
+            csr.offsets[u + 1]++;
+            csr.offsets[v + 1]++;
+        }
+        std::partial_sum(csr.offsets.begin(), csr.offsets.end(), csr.offsets.begin());
+
+        csr.targets.resize(csr.offsets[n]);
+        std::vector<int> fill(csr.offsets.begin(), csr.offsets.end() - 1);
+        for (const auto& [u, v] : edges) {
+            if (u == v) continue;
+            csr.targets[fill[u]++] = v;
+            csr.targets[fill[v]++] = u;
+        }
+
+        // Sort every row and squeeze out duplicates, rows are shifted left in place
+        int write = 0;
+        for (int v = 0; v < n; ++v) {
+            int begin = csr.offsets[v];
+            int end = csr.offsets[v + 1];
+            std::sort(csr.targets.begin() + begin, csr.targets.begin() + end);
+            int rowStart = write;
+            for (int i = begin; i < end; ++i) {
+                if (write > rowStart && csr.targets[write - 1] == csr.targets[i]) continue;
+                csr.targets[write++] = csr.targets[i];
+            }
+            csr.offsets[v] = rowStart;
+        }
+        csr.offsets[n] = write;
+        csr.targets.resize(write);
+        return csr;
+    }
+
+    // Complement without self loops. Every row is merge-walked against 0..n-1; row sizes
+    // are known up front (n - 1 - degree), so blocks of rows can be filled by separate threads.
+    CsrAdjacency complement(int numThreads = 1) const {
+        int n = numVertices();
+        CsrAdjacency csr;
+        csr.offsets.assign(n + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            csr.offsets[v + 1] = csr.offsets[v] + (n - 1 - (offsets[v + 1] - offsets[v]));
+        }
+        csr.targets.resize(csr.offsets[n]);
+
+        auto fillRows = [&](int first, int last) {
+            for (int v = first; v < last; ++v) {
+                const int* neighbor = targets.data() + offsets[v];
+                const int* neighborEnd = targets.data() + offsets[v + 1];
+                int* out = csr.targets.data() + csr.offsets[v];
+                for (int u = 0; u < n; ++u) {
+                    if (neighbor != neighborEnd && *neighbor == u) {
+                        ++neighbor;
+                        continue;
+                    }
+                    if (u != v) *out++ = u;
+                }
+            }
+        };
+
+        int numBlocks = std::max(1, std::min(numThreads, n / 1024));
+        if (numBlocks == 1) {
+            fillRows(0, n);
+            return csr;
+        }
+        std::vector<std::thread> threads;
+        for (int b = 0; b < numBlocks; ++b) {
+            int first = static_cast<int>(static_cast<long long>(n) * b / numBlocks);
+            int last = static_cast<int>(static_cast<long long>(n) * (b + 1) / numBlocks);
+            threads.emplace_back(fillRows, first, last);
+        }
+        for (std::thread& t : threads) t.join();
+        return csr;
+    }
+};
+
+#endif // CSRADJACENCY_HPP
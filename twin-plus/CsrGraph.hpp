@@ -0,0 +1,753 @@
+#ifndef CSRGRAPH_HPP
+#define CSRGRAPH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include "BucketQueue.hpp"
+#include "ComponentSplitter.hpp"
+#include "ContractionSequence.hpp"
+#include "CsrAdjacency.hpp"
+#include "NeighborhoodKernels.hpp"
+#include "PendantQueue.hpp"
+#include "Random.hpp"
+#include "RedDegreeHeuristics.hpp"
+#include "ScoreCache.hpp"
+#include "Telemetry.hpp"
+
+// Graph backend with the same contraction interface as Graph in VectorGraph.hpp.
+// The input is loaded once into an immutable CSR array; everything mergeVertices changes
+// lives in a per-vertex overlay:
+//   - adjListRed: sorted red neighbours created by merges,
+//   - alive: vertices removed by a merge are only marked dead, their CSR entries stay.
+// The black neighbourhood of v is therefore (base row of v) ∩ alive \ adjListRed[v]:
+// a black edge only ever disappears because an endpoint dies or because it turns red.
+// Dead entries are compacted out of a row once they make up half of it.
+//
+// In complement mode (setComplementAdjacency) the base holds the input of a dense instance
+// and the graph being contracted is its complement, which is never materialised. The base
+// row then lists non-neighbours: with M(v) = (base row of v) ∩ alive \ adjListRed[v],
+// N(v) = alive \ {v} \ M(v), and |N(a) Δ N(b)| = |M(a) Δ M(b)| once a and b are left out,
+// so scores and merges only walk the input rows.
+class CsrGraph {
+private:
+    CsrAdjacency base;
+    std::vector<int> rowEnd;    // live prefix of the base row is targets[offsets[v] .. rowEnd[v])
+    std::vector<int> deadInRow; // dead vertices still stored in the live prefix
+    std::vector<char> alive;
+    std::vector<std::vector<int>> adjListRed; // sorted
+    std::vector<int> baseDegree; // live base entries not shadowed by a red edge: black degree, or |M(v)| in complement mode
+    bool complementBase = false;
+    std::vector<unsigned> neighborhoodVersion; // bumped whenever mergeVertices changes N(v), validates ScoreCache entries
+    std::vector<std::pair<int, int>> pendingEdges; // collected by addEdgeBegin until updateBlackDegrees
+    std::vector<int> vertices;
+    std::vector<int> ids; // mapping index -> id, used for connected components
+    BucketQueue redDegreeToVertices;
+    BucketQueue degreeToVertices; // keyed by degreeKey
+    PendantQueue pendants; // fed by updateVertexDegree outside complement mode, drained by reducePendants
+    int width = 0;
+    Xoshiro256 gen;
+    bool printProgress = true; // per-iteration "c" lines, off while components are solved concurrently
+
+    // Scratch buffers reused by mergeVertices
+    std::vector<std::pair<int, bool>> sourceNeighbors;
+    std::vector<std::pair<int, bool>> twinNeighbors;
+    std::vector<int> sourceMask;
+    std::vector<int> twinMask;
+    std::vector<int> twinRed;
+
+    // Walks N(v) = (live base row) ∪ adjListRed[v] in ascending order without materialising it,
+    // in complement mode the live vertices outside M(v) instead
+    class NeighborCursor {
+    public:
+        NeighborCursor(const CsrGraph& g, int v)
+            : alive(g.alive.data()),
+              base(g.base.targets.data() + g.base.offsets[v]),
+              baseEnd(g.base.targets.data() + g.rowEnd[v]),
+              red(g.adjListRed[v].data()),
+              redEnd(g.adjListRed[v].data() + g.adjListRed[v].size()),
+              self(v) {
+            if (g.complementBase) {
+                live = g.vertices.data();
+                liveEnd = g.vertices.data() + g.vertices.size();
+            }
+            advance();
+        }
+
+        bool done() const { return value == INT_MAX; }
+        int get() const { return value; }
+        bool isRed() const { return currentRed; }
+        void next() { advance(); }
+
+    private:
+        const char* alive;
+        const int* base;
+        const int* baseEnd;
+        const int* red;
+        const int* redEnd;
+        const int* live = nullptr; // set in complement mode only
+        const int* liveEnd = nullptr;
+        int self;
+        int value = INT_MAX;
+        bool currentRed = false;
+
+        void advance() {
+            if (live != nullptr) {
+                advanceComplement();
+                return;
+            }
+            while (base != baseEnd && !alive[*base]) ++base;
+            int b = base != baseEnd ? *base : INT_MAX;
+            int r = red != redEnd ? *red : INT_MAX;
+            if (r == INT_MAX && b == INT_MAX) {
+                value = INT_MAX;
+                return;
+            }
+            if (r <= b) {
+                // a red edge shadows the black base entry it replaced
+                value = r;
+                currentRed = true;
+                ++red;
+                if (r == b) ++base;
+            } else {
+                value = b;
+                currentRed = false;
+                ++base;
+            }
+        }
+
+        void advanceComplement() {
+            while (live != liveEnd) {
+                int u = *live++;
+                if (u == self) continue;
+                while (red != redEnd && *red < u) ++red;
+                if (red != redEnd && *red == u) {
+                    value = u;
+                    currentRed = true;
+                    return;
+                }
+                while (base != baseEnd && *base < u) ++base;
+                if (base != baseEnd && *base == u) continue;
+                value = u;
+                currentRed = false;
+                return;
+            }
+            value = INT_MAX;
+        }
+    };
+
+    // Walks M(v) of complement mode, the live non-neighbours of v
+    class NonNeighborCursor {
+    public:
+        NonNeighborCursor(const CsrGraph& g, int v)
+            : alive(g.alive.data()),
+              base(g.base.targets.data() + g.base.offsets[v]),
+              baseEnd(g.base.targets.data() + g.rowEnd[v]),
+              red(g.adjListRed[v].data()),
+              redEnd(g.adjListRed[v].data() + g.adjListRed[v].size()) {
+            skip();
+        }
+
+        bool done() const { return base == baseEnd; }
+        int get() const { return *base; }
+        void next() {
+            ++base;
+            skip();
+        }
+
+    private:
+        const char* alive;
+        const int* base;
+        const int* baseEnd;
+        const int* red;
+        const int* redEnd;
+
+        void skip() {
+            while (base != baseEnd) {
+                if (alive[*base]) {
+                    while (red != redEnd && *red < *base) ++red;
+                    if (red == redEnd || *red != *base) return;
+                }
+                ++base;
+            }
+        }
+    };
+
+    void initFromBase() {
+        int n = base.numVertices();
+        rowEnd.assign(base.offsets.begin() + 1, base.offsets.end());
+        deadInRow.assign(n, 0);
+        alive.assign(n, 1);
+        adjListRed.assign(n, {});
+        neighborhoodVersion.assign(n, 0);
+        baseDegree.resize(n);
+        degreeToVertices.reset(n);
+        redDegreeToVertices.reset(n);
+        pendants.reset(n);
+        for (int v = 0; v < n; ++v) {
+            baseDegree[v] = base.offsets[v + 1] - base.offsets[v];
+            degreeToVertices.push(v, baseDegree[v]);
+            redDegreeToVertices.push(v, 0);
+            if (!complementBase && baseDegree[v] == 1) pendants.push(v);
+        }
+        vertices.resize(n);
+        std::iota(vertices.begin(), vertices.end(), 0);
+        if (ids.size() != static_cast<std::size_t>(n)) ids = vertices;
+    }
+
+    static void insertSorted(std::vector<int>& list, int v) {
+        list.insert(std::lower_bound(list.begin(), list.end(), v), v);
+    }
+
+    static void eraseSorted(std::vector<int>& list, int v) {
+        auto it = std::lower_bound(list.begin(), list.end(), v);
+        if (it != list.end() && *it == v) list.erase(it);
+    }
+
+    bool hasRedEdge(int v1, int v2) const {
+        return std::binary_search(adjListRed[v1].begin(), adjListRed[v1].end(), v2);
+    }
+
+    bool inBaseRow(int v1, int v2) const {
+        auto begin = base.targets.begin() + base.offsets[v1];
+        auto end = base.targets.begin() + rowEnd[v1];
+        return std::binary_search(begin, end, v2);
+    }
+
+    bool hasBlackEdge(int v1, int v2) const {
+        if (!alive[v2] || hasRedEdge(v1, v2)) return false;
+        return inBaseRow(v1, v2);
+    }
+
+    void removeEdge(int v1, int v2, bool red) {
+        updateVertexDegree(v1, -1);
+        updateVertexDegree(v2, -1);
+        if (red) {
+            updateVertexRedDegree(v1, -1);
+            updateVertexRedDegree(v2, -1);
+            eraseSorted(adjListRed[v1], v2);
+            eraseSorted(adjListRed[v2], v1);
+        } else {
+            // the base entry stays, it is hidden once an endpoint dies
+            baseDegree[v1]--;
+            baseDegree[v2]--;
+        }
+    }
+
+    void addRedEdge(int v1, int v2) {
+        updateVertexDegree(v1, 1);
+        updateVertexDegree(v2, 1);
+        updateVertexRedDegree(v1, 1);
+        updateVertexRedDegree(v2, 1);
+        insertSorted(adjListRed[v1], v2);
+        insertSorted(adjListRed[v2], v1);
+    }
+
+    void recolorRed(int v1, int v2) {
+        updateVertexRedDegree(v1, 1);
+        updateVertexRedDegree(v2, 1);
+        baseDegree[v1]--;
+        baseDegree[v2]--;
+        insertSorted(adjListRed[v1], v2);
+        insertSorted(adjListRed[v2], v1);
+    }
+
+    // Expects all edges of the vertex to be removed already
+    void removeVertex(int vertex) {
+        alive[vertex] = 0;
+        vertices.erase(std::find(vertices.begin(), vertices.end(), vertex));
+        redDegreeToVertices.erase(vertex);
+        degreeToVertices.erase(vertex);
+
+        for (int i = base.offsets[vertex]; i < rowEnd[vertex]; ++i) {
+            int neighbor = base.targets[i];
+            if (!alive[neighbor]) continue;
+            if (2 * ++deadInRow[neighbor] > rowEnd[neighbor] - base.offsets[neighbor]) compactRow(neighbor);
+        }
+    }
+
+    void compactRow(int v) {
+        int write = base.offsets[v];
+        for (int i = base.offsets[v]; i < rowEnd[v]; ++i) {
+            if (alive[base.targets[i]]) base.targets[write++] = base.targets[i];
+        }
+        rowEnd[v] = write;
+        deadInRow[v] = 0;
+    }
+
+    void updateVertexRedDegree(int vertex, int diff) {
+        redDegreeToVertices.push(vertex, adjListRed[vertex].size() + diff);
+    }
+
+    // Bucket of vertex in degreeToVertices. Complement degrees shrink with every removed vertex,
+    // so complement mode keys by |M(v)| instead: the lowest degrees sit in the highest buckets.
+    int degreeKey(int vertex) const {
+        if (complementBase) return baseDegree[vertex];
+        return baseDegree[vertex] + adjListRed[vertex].size();
+    }
+
+    int degree(int vertex) const {
+        if (complementBase) return vertices.size() - 1 - baseDegree[vertex];
+        return baseDegree[vertex] + adjListRed[vertex].size();
+    }
+
+    // Complement degrees move with every removed vertex, that mode leaves pendants alone
+    void updateVertexDegree(int vertex, int diff) {
+        degreeToVertices.push(vertex, degreeKey(vertex) + diff);
+        if (!complementBase && degreeKey(vertex) + diff == 1) pendants.push(vertex);
+    }
+
+    // mergeVertices on explicit base rows plus the red overlay
+    void mergeOverlay(int source, int twin) {
+        if (hasRedEdge(source, twin)) removeEdge(source, twin, true);
+        else if (hasBlackEdge(source, twin)) removeEdge(source, twin, false);
+
+        // The removed black edge source-twin is still visible through the base rows
+        // until twin dies, so both walks skip it explicitly.
+        twinNeighbors.clear();
+        for (NeighborCursor c(*this, twin); !c.done(); c.next()) {
+            if (c.get() != source) twinNeighbors.push_back({c.get(), c.isRed()});
+        }
+        for (const auto& [neighbor, red] : twinNeighbors) removeEdge(twin, neighbor, red);
+
+        sourceNeighbors.clear();
+        for (NeighborCursor c(*this, source); !c.done(); c.next()) {
+            if (c.get() != twin) sourceNeighbors.push_back({c.get(), c.isRed()});
+        }
+
+        std::size_t i = 0, j = 0;
+        while (i < sourceNeighbors.size() || j < twinNeighbors.size()) {
+            int s = i < sourceNeighbors.size() ? sourceNeighbors[i].first : INT_MAX;
+            int t = j < twinNeighbors.size() ? twinNeighbors[j].first : INT_MAX;
+            if (s == t) {
+                if (!sourceNeighbors[i].second && twinNeighbors[j].second) recolorRed(source, s);
+                ++i;
+                ++j;
+            } else if (s < t) {
+                if (!sourceNeighbors[i].second) recolorRed(source, s);
+                ++i;
+            } else {
+                addRedEdge(source, t);
+                ++j;
+            }
+        }
+
+        removeVertex(twin);
+        neighborhoodVersion[source]++;
+        for (NeighborCursor c(*this, source); !c.done(); c.next()) neighborhoodVersion[c.get()]++;
+        updateWidth();
+    }
+
+    // mergeVertices for complement mode. A live x ends up red to source iff it was red to either
+    // vertex or adjacent to exactly one of them, i.e. x ∈ red(s) ∪ red(t) ∪ (M(s) Δ M(t)).
+    // Everything else keeps its colour, in particular M(s) ∩ M(t) stays the non-neighbourhood.
+    void mergeComplement(int source, int twin) {
+        sourceMask.clear();
+        for (NonNeighborCursor c(*this, source); !c.done(); c.next()) sourceMask.push_back(c.get());
+        twinMask.clear();
+        for (NonNeighborCursor c(*this, twin); !c.done(); c.next()) twinMask.push_back(c.get());
+        twinRed = adjListRed[twin];
+
+        // twin leaves: its red edges go, and it drops out of every M(x) it was part of
+        for (int x : twinRed) {
+            updateVertexRedDegree(x, -1);
+            updateVertexRedDegree(twin, -1);
+            eraseSorted(adjListRed[x], twin);
+            eraseSorted(adjListRed[twin], x);
+        }
+        for (int x : twinMask) {
+            updateVertexDegree(x, -1);
+            baseDegree[x]--;
+        }
+        baseDegree[twin] = 0;
+        removeVertex(twin);
+
+        auto turnRed = [&](int x, bool wasNonNeighbor) {
+            if (x == source || x == twin || hasRedEdge(source, x)) return;
+            if (wasNonNeighbor) {
+                updateVertexDegree(source, -1);
+                updateVertexDegree(x, -1);
+                baseDegree[source]--;
+                baseDegree[x]--;
+            }
+            updateVertexRedDegree(source, 1);
+            updateVertexRedDegree(x, 1);
+            insertSorted(adjListRed[source], x);
+            insertSorted(adjListRed[x], source);
+            neighborhoodVersion[x]++;
+        };
+
+        std::size_t i = 0, j = 0;
+        while (i < sourceMask.size() || j < twinMask.size()) {
+            int s = i < sourceMask.size() ? sourceMask[i] : INT_MAX;
+            int t = j < twinMask.size() ? twinMask[j] : INT_MAX;
+            if (s == t) {
+                ++i;
+                ++j;
+            } else if (s < t) {
+                turnRed(s, true);
+                ++i;
+            } else {
+                turnRed(t, false);
+                ++j;
+            }
+        }
+        // red to twin means not in M(twin), so only the ones outside M(source) are left
+        for (int x : twinRed) {
+            if (!std::binary_search(sourceMask.begin(), sourceMask.end(), x)) turnRed(x, false);
+        }
+
+        // Pairs whose score changed have one member in M(twin) (twin left its Δ),
+        // are source, or got a new red edge to source (bumped in turnRed)
+        neighborhoodVersion[source]++;
+        for (int x : twinMask) neighborhoodVersion[x]++;
+        updateWidth();
+    }
+
+    // Connected components of the complement: BFS over the unvisited vertices, everything
+    // not in the base row of the current vertex is adjacent to it. Kept vertices are paid
+    // for by base entries, so this is O(n + m) without listing a single complement edge.
+    std::vector<std::vector<int>> findComplementComponents() const {
+        std::vector<int> unvisited(vertices);
+        std::vector<std::vector<int>> components;
+        std::vector<int> queue;
+        std::vector<int> kept;
+        while (!unvisited.empty()) {
+            components.push_back({});
+            queue.assign(1, unvisited.back());
+            unvisited.pop_back();
+            while (!queue.empty()) {
+                int v = queue.back();
+                queue.pop_back();
+                components.back().push_back(v);
+
+                const int* row = base.targets.data() + base.offsets[v];
+                const int* rowEndPtr = base.targets.data() + rowEnd[v];
+                kept.clear();
+                for (int u : unvisited) {
+                    while (row != rowEndPtr && *row < u) ++row;
+                    if (row != rowEndPtr && *row == u) kept.push_back(u);
+                    else queue.push_back(u);
+                }
+                unvisited.swap(kept);
+            }
+            std::sort(components.back().begin(), components.back().end());
+        }
+        return components;
+    }
+
+    void updateWidth() {
+        width = std::max(width, redDegreeToVertices.maxKey());
+    }
+
+public:
+    CsrGraph() : gen(12345) {}
+
+    explicit CsrGraph(CsrAdjacency adjacency) : base(std::move(adjacency)), gen(12345) {
+        initFromBase();
+    }
+
+    // Adds n vertices to the graph numbered from 0 to n-1
+    void addVertices(int n) {
+        std::vector<int> identity(n);
+        std::iota(identity.begin(), identity.end(), 0);
+        addVertices(n, identity);
+    }
+
+    void addVertices(int n, std::vector<int> ids) {
+        this->ids = ids;
+        base.offsets.assign(n + 1, 0);
+        base.targets.clear();
+        initFromBase();
+    }
+
+    void setIds(std::vector<int> values) {
+        ids = values;
+    }
+
+    void setPrintProgress(bool enabled) {
+        printProgress = enabled;
+    }
+
+    bool getPrintProgress() const {
+        return printProgress;
+    }
+
+    // CsrGraph runs are neither raced nor restarted, nothing stops them early
+    bool searchAborted() const {
+        return false;
+    }
+
+    void addEdgeBegin(int v1, int v2) {
+        pendingEdges.push_back({v1, v2});
+    }
+
+    // Bulk alternative to addEdgeBegin, takes a prebuilt adjacency such as the one solve() packs GrReader edges into
+    void setBlackAdjacency(CsrAdjacency csr) {
+        base = std::move(csr);
+        complementBase = false;
+        pendingEdges.clear();
+    }
+
+    // Contracts the complement of csr without building it, see the class comment
+    void setComplementAdjacency(CsrAdjacency csr) {
+        base = std::move(csr);
+        complementBase = true;
+        pendingEdges.clear();
+    }
+
+    // Freezes the edges collected by addEdgeBegin into the CSR base
+    void updateBlackDegrees() {
+        if (!pendingEdges.empty()) base = CsrAdjacency::fromEdges(ids.size(), pendingEdges);
+        pendingEdges.clear();
+        pendingEdges.shrink_to_fit();
+        initFromBase();
+    }
+
+    int getVertexId(int v) {
+        return ids[v];
+    }
+
+    int getWidth() const {
+        return width;
+    }
+
+    const std::vector<int>& getVertices() const {
+        return vertices;
+    }
+
+    std::vector<int> getIds() {
+        return ids;
+    }
+
+    std::vector<int> getNeighbors(int vertex) const {
+        std::vector<int> neighbors;
+        for (NeighborCursor c(*this, vertex); !c.done(); c.next()) neighbors.push_back(c.get());
+        return neighbors;
+    }
+
+    // Components relabelled to 0..size-1, ids map back to this graph's ids; each component's
+    // base is its slice of this base, cut out by ComponentSplitter in one pass. A graph with
+    // a single component is moved into the result as is.
+    std::vector<CsrGraph> splitComponents() && {
+        if (complementBase) return splitComplementComponents();
+
+        auto forEachNeighbor = [&](int v, auto visit) {
+            for (NeighborCursor c(*this, v); !c.done(); c.next()) visit(c.get());
+        };
+        ComponentSplitter splitter(ids.size(), forEachNeighbor);
+        std::vector<CsrGraph> result;
+        if (splitter.numComponents() == 1) {
+            result.push_back(std::move(*this));
+            return result;
+        }
+
+        std::vector<std::vector<int>> members = splitter.members();
+        std::vector<CsrAdjacency> slices = splitter.slices(forEachNeighbor);
+        result.resize(members.size());
+        for (std::size_t c = 0; c < members.size(); ++c) {
+            for (int& v : members[c]) v = ids[v];
+            result[c].ids = std::move(members[c]);
+            result[c].base = std::move(slices[c]);
+            result[c].initFromBase();
+        }
+        return result;
+    }
+
+    // splitComponents for complement mode, every component keeps the input
+    // edges among its own vertices as its (complement) base
+    std::vector<CsrGraph> splitComplementComponents() {
+        std::vector<std::vector<int>> componentVertices = findComplementComponents();
+        std::vector<CsrGraph> result;
+        if (componentVertices.size() == 1) {
+            result.push_back(std::move(*this));
+            return result;
+        }
+
+        std::vector<int> componentOf(ids.size());
+        std::vector<int> localIndex(ids.size());
+        for (std::size_t i = 0; i < componentVertices.size(); ++i) {
+            for (std::size_t j = 0; j < componentVertices[i].size(); ++j) {
+                componentOf[componentVertices[i][j]] = i;
+                localIndex[componentVertices[i][j]] = j;
+            }
+        }
+        for (std::size_t i = 0; i < componentVertices.size(); ++i) {
+            std::vector<std::pair<int, int>> edges;
+            std::vector<int> componentIds(componentVertices[i].size());
+            for (int v : componentVertices[i]) {
+                componentIds[localIndex[v]] = ids[v];
+                for (int k = base.offsets[v]; k < rowEnd[v]; ++k) {
+                    int u = base.targets[k];
+                    if (u > v && componentOf[u] == static_cast<int>(i)) edges.push_back({localIndex[v], localIndex[u]});
+                }
+            }
+
+            CsrGraph g;
+            g.ids = componentIds;
+            g.complementBase = true;
+            g.base = CsrAdjacency::fromEdges(componentIds.size(), edges);
+            g.initFromBase();
+            result.push_back(std::move(g));
+        }
+        return result;
+    }
+
+    float getDegreeDeviation() {
+        int totalVertices = vertices.size();
+        int totalDegree = 0;
+        auto bucketDegree = [&](int key) { return complementBase ? totalVertices - 1 - key : key; };
+        for (int i = 0; i < degreeToVertices.numKeys(); ++i) {
+            totalDegree += bucketDegree(i) * degreeToVertices.bucketSize(i);
+        }
+        float meanDegree = static_cast<float>(totalDegree) / totalVertices;
+
+        float sumAbsoluteDeviations = 0.0;
+        for (int i = 0; i < degreeToVertices.numKeys(); ++i) {
+            sumAbsoluteDeviations += std::abs(bucketDegree(i) - meanDegree) * degreeToVertices.bucketSize(i);
+        }
+        return sumAbsoluteDeviations / totalVertices;
+    }
+
+    std::vector<int> getTopNVerticesWithLowestRedDegree(int n) {
+        return redDegreeToVertices.getTopNLowest(n);
+    }
+
+    std::vector<int> getTopNVerticesWithLowestDegree(int n) {
+        if (complementBase) return degreeToVertices.getTopNHighest(n);
+        return degreeToVertices.getTopNLowest(n);
+    }
+
+    // n vertices drawn without replacement, all of them when there are fewer
+    std::vector<int> getRandomVertices(int n) {
+        std::vector<int> sample(vertices);
+        std::shuffle(sample.begin(), sample.end(), gen);
+        sample.resize(std::min<std::size_t>(sample.size(), n));
+        return sample;
+    }
+
+    // Size of the symmetric difference of both neighbourhoods without v1 and v2 themselves
+    int getScore(int v1, int v2) const {
+        if (complementBase) return countMerge(NonNeighborCursor(*this, v1), NonNeighborCursor(*this, v2), v1, v2).symmetricDifference();
+        return countMerge(NeighborCursor(*this, v1), NeighborCursor(*this, v2), v1, v2).symmetricDifference();
+    }
+
+    // Same result as Graph::mergeVertices: source keeps the black edges shared with twin,
+    // every other edge of either vertex becomes a red edge of source, and twin is removed.
+    void mergeVertices(int source, int twin) {
+        auto start = std::chrono::steady_clock::now();
+        if (complementBase) mergeComplement(source, twin);
+        else mergeOverlay(source, twin);
+        telemetry.count(Telemetry::MERGES);
+        telemetry.record(Telemetry::MERGE_NS, Telemetry::nanosecondsSince(start));
+    }
+
+    int getCachedScore(ScoreCache& cache, int v1, int v2) {
+        int score;
+        if (!cache.find(v1, v2, neighborhoodVersion, score)) {
+            score = getScore(v1, v2);
+            cache.store(v1, v2, neighborhoodVersion, score);
+            telemetry.count(Telemetry::CACHE_MISSES);
+        }
+        else telemetry.count(Telemetry::CACHE_HITS);
+        return score;
+    }
+
+    // Graph::scoreCandidatePairs on the calling thread: every pair of candidates, larger
+    // vertex first, in the order of the serial double loop
+    void scoreCandidatePairs(ScoreCache& cache, const std::vector<int>& candidates,
+                             std::vector<std::pair<int, int>>& pairs, std::vector<int>& pairScores) {
+        auto start = std::chrono::steady_clock::now();
+        pairs.clear();
+        pairScores.clear();
+        for (std::size_t i = 0; i < candidates.size(); i++) {
+            for (std::size_t j = i + 1; j < candidates.size(); j++) {
+                int v1 = candidates[i];
+                int v2 = candidates[j];
+                if (v2 > v1) {
+                    std::swap(v1, v2);
+                }
+                pairs.push_back({v1, v2});
+                pairScores.push_back(getCachedScore(cache, v1, v2));
+            }
+        }
+        telemetry.record(Telemetry::CANDIDATES, pairs.size());
+        telemetry.record(Telemetry::SCORE_NS, Telemetry::nanosecondsSince(start));
+    }
+
+    int getRandomDistance() {
+        return 1 + gen.below(2);
+    }
+
+    // Uniform over N(vertex) by rejection: draw an index into (live base row) + adjListRed and
+    // retry on dead entries and on base entries shadowed by a red edge. Compaction keeps at most
+    // half of a row dead and every shadowed entry has its red twin in the range, so a draw hits
+    // with constant probability. In complement mode the draw is over all live vertices, which
+    // only pays for the dense rows that mode is for; after MAX_ATTEMPTS misses the neighbourhood
+    // is listed instead. An isolated vertex returns itself, which getRandomWalkVertices drops.
+    int getRandomNeighbor(int vertex) {
+        const int MAX_ATTEMPTS = 16;
+        if (degree(vertex) == 0) return vertex;
+        const std::vector<int>& red = adjListRed[vertex];
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+            if (complementBase) {
+                int u = vertices[gen.below(vertices.size())];
+                if (u != vertex && (hasRedEdge(vertex, u) || !inBaseRow(vertex, u))) return u;
+                continue;
+            }
+            int rowSize = rowEnd[vertex] - base.offsets[vertex];
+            std::uint32_t i = gen.below(rowSize + red.size());
+            if (i >= static_cast<std::uint32_t>(rowSize)) return red[i - rowSize];
+            int u = base.targets[base.offsets[vertex] + i];
+            if (alive[u] && !hasRedEdge(vertex, u)) return u;
+        }
+        std::vector<int> allNeighbors = getNeighbors(vertex);
+        return allNeighbors[gen.below(allNeighbors.size())];
+    }
+
+    std::set<int> getRandomWalkVertices(int vertex, int numberVertices) {
+        std::set<int> randomWalkVertices;
+        for (int i = 0; i < numberVertices; ++i) {
+            int distance = getRandomDistance();
+            int randomVertex = getRandomNeighbor(vertex);
+            if (distance == 2 && degree(randomVertex) != 0) randomVertex = getRandomNeighbor(randomVertex);
+            randomWalkVertices.insert(randomVertex);
+        }
+        randomWalkVertices.erase(vertex);
+        return randomWalkVertices;
+    }
+
+    // Contracts leaves with a common neighbour, see PendantQueue; called at the top of every
+    // iteration of the heuristics
+    int reducePendants(ContractionSequence& contractionSequence) {
+        if (!pendantReduction) return 0;
+        auto parentOf = [&](int v) {
+            if (complementBase || !alive[v] || degree(v) != 1) return -1;
+            return NeighborCursor(*this, v).get();
+        };
+        int merges = pendants.drain(parentOf, [&](int leaf, int v) {
+            contractionSequence.add(getVertexId(leaf) + 1, getVertexId(v) + 1);
+            mergeVertices(leaf, v);
+        });
+        telemetry.count(Telemetry::PENDANT_MERGES, merges);
+        return merges;
+    }
+
+    ContractionSequence findRedDegreeContraction() {
+        return RedDegreeHeuristics::lowestPairs(*this);
+    }
+
+    ContractionSequence findRedDegreeContractionRandomWalk() {
+        return RedDegreeHeuristics::randomWalk(*this);
+    }
+};
+
+#endif // CSRGRAPH_HPP
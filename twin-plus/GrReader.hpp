@@ -0,0 +1,120 @@
+#ifndef GRREADER_HPP
+#define GRREADER_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Edge list of a PACE .gr instance, vertices already shifted to 0-based
+struct GrInstance {
+    int numVertices = 0;
+    long long numEdges = 0; // as announced in the p line
+    std::vector<std::pair<int, int>> edges;
+};
+
+// Reads .gr files without getline/stringstream/stoi: a regular file (also stdin
+// redirected from one) is memory-mapped, pipes are slurped in large blocks, and
+// one pass with a hand-written scanner fills an edge array pre-sized from the p line.
+class GrReader {
+public:
+    // path == nullptr reads stdin
+    static GrInstance read(const char* path = nullptr) {
+        int fd = 0;
+        if (path != nullptr) {
+            fd = ::open(path, O_RDONLY);
+            if (fd < 0) throw std::runtime_error(std::string("Cannot open ") + path);
+        }
+
+        GrInstance instance;
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            std::size_t size = info.st_size;
+            void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                ::madvise(data, size, MADV_SEQUENTIAL);
+                const char* begin = static_cast<const char*>(data);
+                try {
+                    instance = parse(begin, begin + size);
+                } catch (...) {
+                    ::munmap(data, size);
+                    if (path != nullptr) ::close(fd);
+                    throw;
+                }
+                ::munmap(data, size);
+                if (path != nullptr) ::close(fd);
+                return instance;
+            }
+        }
+
+        std::vector<char> buffer;
+        const std::size_t BLOCK_SIZE = std::size_t(1) << 22;
+        std::size_t used = 0;
+        while (true) {
+            buffer.resize(used + BLOCK_SIZE);
+            ssize_t got = ::read(fd, buffer.data() + used, BLOCK_SIZE);
+            if (got <= 0) break;
+            used += got;
+        }
+        if (path != nullptr) ::close(fd);
+        return parse(buffer.data(), buffer.data() + used);
+    }
+
+private:
+    static bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    static const char* skipLine(const char* p, const char* end) {
+        while (p < end && *p != '\n') ++p;
+        return p < end ? p + 1 : p;
+    }
+
+    static long long readInt(const char*& p, const char* end) {
+        while (p < end && isBlank(*p)) ++p;
+        if (p == end || *p < '0' || *p > '9') throw std::runtime_error("Malformed .gr line: expected a number");
+        long long value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            ++p;
+        }
+        return value;
+    }
+
+    static GrInstance parse(const char* p, const char* end) {
+        GrInstance instance;
+        while (p < end) {
+            while (p < end && (isBlank(*p) || *p == '\n')) ++p;
+            if (p == end) break;
+
+            if (*p == 'c') {
+                p = skipLine(p, end);
+            } else if (*p == 'p') {
+                ++p;
+                while (p < end && isBlank(*p)) ++p;
+                while (p < end && !isBlank(*p) && *p != '\n') ++p; // problem descriptor, "tww"
+                instance.numVertices = static_cast<int>(readInt(p, end));
+                instance.numEdges = readInt(p, end);
+                instance.edges.reserve(instance.numEdges);
+                p = skipLine(p, end);
+            } else {
+                long long u = readInt(p, end);
+                long long v = readInt(p, end);
+                // everything downstream indexes arrays of numVertices by these
+                if (u < 1 || u > instance.numVertices || v < 1 || v > instance.numVertices) {
+                    throw std::runtime_error("Malformed .gr line: vertex out of range 1.." + std::to_string(instance.numVertices));
+                }
+                instance.edges.emplace_back(static_cast<int>(u - 1), static_cast<int>(v - 1));
+                p = skipLine(p, end);
+            }
+        }
+        return instance;
+    }
+};
+
+#endif // GRREADER_HPP
@@ -0,0 +1,155 @@
+#ifndef LOWERBOUND_HPP
+#define LOWERBOUND_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <vector>
+#include "BitsetAdjacency.hpp"
+#include "CsrAdjacency.hpp"
+
+// Lower bounds on the twin-width of a graph. Every sequence starts with some merge, and
+// merging u and v leaves a vertex of red degree |N(u) Δ N(v) \ {u, v}|, so the minimum of
+// that over all pairs bounds the width from below. Twin-width never grows when passing to
+// an induced subgraph, so the same bound on any induced subgraph holds for the graph too;
+// raise() tries the k-cores, which drop the low degree vertices that keep the minimum of
+// sparse graphs small. All loops poll stop once per vertex.
+class LowerBound {
+public:
+    // min over pairs u != v of |N(u) Δ N(v) \ {u, v}|, -1 if stop was raised first.
+    // Pairs without a common neighbour that are not adjacent either score deg u + deg v,
+    // all of them are covered by the two smallest degrees; the others are found from u
+    // over paths of length two, or on the bitset matrix where that is cheaper.
+    static int firstMerge(const CsrAdjacency& g, const std::atomic<bool>& stop) {
+        int n = g.numVertices();
+        if (n < 2) return 0;
+        std::vector<int> degrees(n);
+        double twoHopCost = 0;
+        for (int v = 0; v < n; ++v) {
+            degrees[v] = g.offsets[v + 1] - g.offsets[v];
+            twoHopCost += double(degrees[v]) * degrees[v];
+        }
+        std::vector<int> smallest(degrees);
+        std::partial_sort(smallest.begin(), smallest.begin() + 2, smallest.end());
+        int best = smallest[0] + smallest[1];
+
+        // XOR + popcount costs rowWords / 8 SIMD steps per pair
+        double bitsetCost = double(n) * (n - 1) / 2 * (BitsetAdjacency::rowWords(n) / 8);
+        BitsetAdjacency bits;
+        if (bitsetCost < twoHopCost && bits.allocate(n)) {
+            for (int u = 0; u < n; ++u) {
+                for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) bits.addEdge(u, g.targets[i]);
+            }
+            for (int u = 0; u < n && best > 0; ++u) {
+                if (stop.load(std::memory_order_relaxed)) return -1;
+                for (int v = u + 1; v < n; ++v) best = std::min(best, bits.symmetricDifference(u, v));
+            }
+            return best;
+        }
+
+        std::vector<int> common(n, 0);
+        std::vector<char> adjacent(n, 0);
+        std::vector<int> touched;
+        for (int u = 0; u < n && best > 0; ++u) {
+            if (stop.load(std::memory_order_relaxed)) return -1;
+            touched.clear();
+            for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                int w = g.targets[i];
+                adjacent[w] = 1;
+                if (w > u && common[w]++ == 0) touched.push_back(w);
+                for (int j = g.offsets[w]; j < g.offsets[w + 1]; ++j) {
+                    int v = g.targets[j];
+                    if (v > u && common[v]++ == 0) touched.push_back(v);
+                }
+            }
+            for (int v : touched) {
+                // common[v] counts the paths u-w-v, plus one if v itself is a neighbour
+                int shared = common[v] - adjacent[v];
+                best = std::min(best, degrees[u] + degrees[v] - 2 * shared - 2 * adjacent[v]);
+                common[v] = 0;
+            }
+            for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) adjacent[g.targets[i]] = 0;
+        }
+        return best;
+    }
+
+    // Raises bound to firstMerge of every distinct k-core of g, the innermost (smallest) core
+    // first, so a first bound is published quickly and the larger cores only ever raise it
+    static void raise(const CsrAdjacency& g, std::atomic<int>& bound, const std::atomic<bool>& stop) {
+        int n = g.numVertices();
+        std::vector<int> core = coreNumbers(g);
+        std::vector<int> levels(core);
+        std::sort(levels.begin(), levels.end());
+        levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+        for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+            std::vector<int> keep;
+            for (int v = 0; v < n; ++v) {
+                if (core[v] >= *level) keep.push_back(v);
+            }
+            int value = firstMerge(induced(g, keep), stop);
+            if (value < 0) return;
+            int current = bound.load(std::memory_order_relaxed);
+            while (value > current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+    }
+
+private:
+    // Core number of every vertex (Batagelj and Zaversnik): vertices are peeled in order of
+    // their current degree with a bucket sort, O(n + m)
+    static std::vector<int> coreNumbers(const CsrAdjacency& g) {
+        int n = g.numVertices();
+        std::vector<int> degree(n);
+        int maxDegree = 0;
+        for (int v = 0; v < n; ++v) {
+            degree[v] = g.offsets[v + 1] - g.offsets[v];
+            maxDegree = std::max(maxDegree, degree[v]);
+        }
+        std::vector<int> binStart(maxDegree + 2, 0);
+        for (int v = 0; v < n; ++v) binStart[degree[v] + 1]++;
+        for (int d = 1; d <= maxDegree + 1; ++d) binStart[d] += binStart[d - 1];
+        std::vector<int> order(n);
+        std::vector<int> position(n);
+        std::vector<int> fill(binStart.begin(), binStart.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            position[v] = fill[degree[v]]++;
+            order[position[v]] = v;
+        }
+        for (int i = 0; i < n; ++i) {
+            int v = order[i];
+            for (int j = g.offsets[v]; j < g.offsets[v + 1]; ++j) {
+                int u = g.targets[j];
+                if (degree[u] <= degree[v]) continue;
+                // move u to the front of its bin, then shrink the bin past it
+                int front = binStart[degree[u]];
+                int w = order[front];
+                if (w != u) {
+                    std::swap(order[front], order[position[u]]);
+                    position[w] = position[u];
+                    position[u] = front;
+                }
+                binStart[degree[u]]++;
+                degree[u]--;
+            }
+        }
+        return degree;
+    }
+
+    // g restricted to keep (ascending), relabelled to 0..|keep|-1 in the same order
+    static CsrAdjacency induced(const CsrAdjacency& g, const std::vector<int>& keep) {
+        std::vector<int> localIndex(g.numVertices(), -1);
+        for (std::size_t i = 0; i < keep.size(); ++i) localIndex[keep[i]] = static_cast<int>(i);
+        CsrAdjacency result;
+        result.offsets.reserve(keep.size() + 1);
+        result.offsets.push_back(0);
+        for (int v : keep) {
+            for (int j = g.offsets[v]; j < g.offsets[v + 1]; ++j) {
+                if (localIndex[g.targets[j]] >= 0) result.targets.push_back(localIndex[g.targets[j]]);
+            }
+            result.offsets.push_back(static_cast<int>(result.targets.size()));
+        }
+        return result;
+    }
+};
+
+#endif // LOWERBOUND_HPP
@@ -0,0 +1,245 @@
+#ifndef MINHASHINDEX_HPP
+#define MINHASHINDEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <unordered_dense.h>
+
+// Locality-sensitive index of near twins over the whole graph. Every vertex gets a MinHash
+// signature of its neighbourhood: SIGNATURE_SIZE minima of independent hash functions, two
+// signatures agree in a position with probability equal to the Jaccard similarity of the
+// neighbourhoods. The signature is cut into BANDS bands of ROWS values and every band is
+// hashed into a bucket, so near twins share a bucket in some band with high probability
+// while unrelated vertices rarely do. A vertex entering a bucket is paired with the last
+// few vertices there, and the pair is queued with the number of agreeing positions as its
+// priority. Pairs carry the versions of both vertices and are dropped when popped stale,
+// so topPairs costs O(k log q) plus the stale pops, independent of the graph size.
+//
+// A merge only changes the neighbourhoods of the survivor and its neighbours afterwards,
+// and for the neighbours only by the removed vertex and the survivor: their signatures are
+// patched position by position and only rebuilt where the minimum belonged to a vertex
+// that left, see merged().
+class MinHashIndex {
+public:
+    static constexpr int BANDS = 16;
+    static constexpr int ROWS = 4;
+    static constexpr int SIGNATURE_SIZE = BANDS * ROWS;
+    static constexpr int BUCKET_PARTNERS = 4; // most recent members of a bucket paired with a newcomer
+
+    struct Candidate {
+        int agreement; // positions out of SIGNATURE_SIZE in which the signatures agree
+        int u;
+        int v;
+    };
+
+    // forEachNeighbor(v, visit) calls visit(u) for every current neighbour u of v;
+    // vertices are the ones present, indices below n
+    template <typename ForEachNeighbor>
+    MinHashIndex(const std::vector<int>& vertices, int n, ForEachNeighbor forEachNeighbor)
+        : signatures(static_cast<std::size_t>(n) * SIGNATURE_SIZE),
+          bandKeys(static_cast<std::size_t>(n) * BANDS, EMPTY),
+          versions(n, 0),
+          present(n, 0) {
+        std::uint64_t state = 0x5eed;
+        for (int j = 0; j < SIGNATURE_SIZE; ++j) {
+            multipliers[j] = mix(state += 0x9e3779b97f4a7c15ULL) | 1;
+            offsets[j] = mix(state += 0x9e3779b97f4a7c15ULL);
+        }
+        for (int v : vertices) {
+            present[v] = 1;
+            recompute(v, forEachNeighbor);
+            reinsert(v);
+        }
+    }
+
+    // To be called after the graph merged removed into survivor. N(survivor) is now
+    // N(survivor) ∪ N(removed) without the two, every other changed vertex is a neighbour
+    // of survivor that lost removed and gained survivor.
+    template <typename ForEachNeighbor>
+    void merged(int survivor, int removed, ForEachNeighbor forEachNeighbor) {
+        present[removed] = 0;
+        versions[removed]++;
+
+        std::uint32_t* s = signature(survivor);
+        const std::uint32_t* t = signature(removed);
+        std::uint64_t survivorKey = key(survivor);
+        std::uint64_t removedKey = key(removed);
+        bool stale = false;
+        for (int j = 0; j < SIGNATURE_SIZE; ++j) {
+            s[j] = std::min(s[j], t[j]);
+            stale |= s[j] == hash(j, survivorKey) || s[j] == hash(j, removedKey);
+        }
+        if (stale) recompute(survivor, forEachNeighbor);
+        reinsert(survivor);
+
+        forEachNeighbor(survivor, [&](int x) {
+            std::uint32_t* sx = signature(x);
+            bool staleNeighbor = false;
+            for (int j = 0; j < SIGNATURE_SIZE; ++j) {
+                staleNeighbor |= sx[j] == hash(j, removedKey);
+                sx[j] = std::min(sx[j], hash(j, survivorKey));
+            }
+            if (staleNeighbor) recompute(x, forEachNeighbor);
+            reinsert(x);
+        });
+    }
+
+    // Up to k distinct current pairs with the most agreeing positions. They stay queued,
+    // a pair is only dropped once one of its vertices changes.
+    std::vector<Candidate> topPairs(int k) {
+        std::vector<Candidate> result;
+        while (result.size() < static_cast<std::size_t>(k) && !queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), lessAgreement);
+            Entry entry = queue.back();
+            queue.pop_back();
+            if (!valid(entry)) continue;
+            // the same pair is queued once per band it shares, keep only one copy; k is small
+            bool duplicate = std::any_of(result.begin(), result.end(), [&](const Candidate& c) {
+                return std::min(c.u, c.v) == std::min(entry.u, entry.v) && std::max(c.u, c.v) == std::max(entry.u, entry.v);
+            });
+            if (duplicate) continue;
+            result.push_back({entry.agreement, entry.u, entry.v});
+            kept.push_back(entry);
+        }
+        for (const Entry& entry : kept) push(entry);
+        kept.clear();
+        return result;
+    }
+
+private:
+    struct Entry {
+        int agreement;
+        int u;
+        int v;
+        unsigned versionU;
+        unsigned versionV;
+    };
+
+    static constexpr std::uint64_t EMPTY = 0; // band key of a vertex that is in no bucket
+
+    std::uint64_t multipliers[SIGNATURE_SIZE];
+    std::uint64_t offsets[SIGNATURE_SIZE];
+    std::vector<std::uint32_t> signatures;
+    std::vector<std::uint64_t> bandKeys;
+    std::vector<unsigned> versions; // bumped whenever a signature changes, invalidates queued pairs
+    std::vector<char> present;
+    // band keys include the band; a bucket only remembers its latest members, older ones
+    // already had their chance to pair with the ones after them
+    ankerl::unordered_dense::map<std::uint64_t, std::array<int, BUCKET_PARTNERS>> buckets;
+    std::vector<Entry> queue; // max-heap on agreement
+    std::vector<Entry> kept;
+    std::size_t compactAt = std::size_t(1) << 16;
+
+    // splitmix64 finalizer
+    static std::uint64_t mix(std::uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static std::uint64_t key(int v) {
+        return mix(static_cast<std::uint64_t>(v) + 0x9e3779b97f4a7c15ULL);
+    }
+
+    // Multiply-shift over the scrambled vertex key, one odd multiplier per position
+    std::uint32_t hash(int j, std::uint64_t vertexKey) const {
+        return static_cast<std::uint32_t>((vertexKey * multipliers[j] + offsets[j]) >> 32);
+    }
+
+    std::uint32_t* signature(int v) {
+        return signatures.data() + static_cast<std::size_t>(v) * SIGNATURE_SIZE;
+    }
+
+    const std::uint32_t* signature(int v) const {
+        return signatures.data() + static_cast<std::size_t>(v) * SIGNATURE_SIZE;
+    }
+
+    template <typename ForEachNeighbor>
+    void recompute(int v, ForEachNeighbor& forEachNeighbor) {
+        std::uint32_t* s = signature(v);
+        std::fill(s, s + SIGNATURE_SIZE, UINT32_MAX);
+        forEachNeighbor(v, [&](int u) {
+            std::uint64_t k = key(u);
+            for (int j = 0; j < SIGNATURE_SIZE; ++j) s[j] = std::min(s[j], hash(j, k));
+        });
+    }
+
+    int agreement(int u, int v) const {
+        const std::uint32_t* a = signature(u);
+        const std::uint32_t* b = signature(v);
+        int count = 0;
+        for (int j = 0; j < SIGNATURE_SIZE; ++j) count += a[j] == b[j];
+        return count;
+    }
+
+    bool valid(const Entry& entry) const {
+        return present[entry.u] && present[entry.v] && versions[entry.u] == entry.versionU && versions[entry.v] == entry.versionV;
+    }
+
+    static bool lessAgreement(const Entry& a, const Entry& b) {
+        return a.agreement < b.agreement;
+    }
+
+    void push(const Entry& entry) {
+        queue.push_back(entry);
+        std::push_heap(queue.begin(), queue.end(), lessAgreement);
+        if (queue.size() < compactAt) return;
+        // Stale pairs are only dropped when popped; sweep them out once they pile up
+        queue.erase(std::remove_if(queue.begin(), queue.end(), [&](const Entry& e) { return !valid(e); }), queue.end());
+        std::make_heap(queue.begin(), queue.end(), lessAgreement);
+        compactAt = std::max(compactAt, 2 * queue.size());
+    }
+
+    bool member(int u, std::uint64_t bandKey, int band) const {
+        return u >= 0 && present[u] && bandKeys[static_cast<std::size_t>(u) * BANDS + band] == bandKey;
+    }
+
+    // Erases a bucket once none of the members it remembers is still in it
+    void dropIfEmpty(std::uint64_t bandKey, int band) {
+        auto it = buckets.find(bandKey);
+        if (it == buckets.end()) return;
+        for (int u : it->second) {
+            if (member(u, bandKey, band)) return;
+        }
+        buckets.erase(it);
+    }
+
+    // Moves v into the buckets of its current bands and queues it with the latest members
+    void reinsert(int v) {
+        versions[v]++;
+        const std::uint32_t* s = signature(v);
+        bool isolated = s[0] == UINT32_MAX; // no neighbour, nothing to compare
+        for (int b = 0; b < BANDS; ++b) {
+            std::uint64_t bandKey = EMPTY;
+            if (!isolated) {
+                bandKey = mix(b + 1);
+                for (int r = 0; r < ROWS; ++r) bandKey = mix(bandKey ^ s[b * ROWS + r]);
+                if (bandKey == EMPTY) bandKey = 1;
+            }
+            std::uint64_t& current = bandKeys[static_cast<std::size_t>(v) * BANDS + b];
+            bool moved = current != bandKey;
+            std::uint64_t previous = current;
+            current = bandKey;
+            if (moved && previous != EMPTY) dropIfEmpty(previous, b);
+            if (bandKey == EMPTY) continue;
+
+            auto [entry, inserted] = buckets.try_emplace(bandKey);
+            std::array<int, BUCKET_PARTNERS>& bucket = entry->second;
+            if (inserted) bucket.fill(-1);
+            for (int u : bucket) {
+                if (u == v || !member(u, bandKey, b)) continue;
+                push({agreement(u, v), u, v, versions[u], versions[v]});
+            }
+            if (moved) {
+                std::rotate(bucket.begin(), bucket.end() - 1, bucket.end());
+                bucket[0] = v;
+            }
+        }
+    }
+};
+
+#endif // MINHASHINDEX_HPP
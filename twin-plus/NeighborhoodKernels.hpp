@@ -0,0 +1,83 @@
+#ifndef NEIGHBORHOODKERNELS_HPP
+#define NEIGHBORHOODKERNELS_HPP
+
+#include <vector>
+
+// Counting-only set kernels over sorted neighbourhoods. One merge walk yields the
+// symmetric difference, intersection and union sizes at once, nothing is allocated.
+
+struct MergeCounts {
+    int onlyFirst = 0;
+    int onlySecond = 0;
+    int common = 0;
+
+    int symmetricDifference() const { return onlyFirst + onlySecond; }
+    int intersection() const { return common; }
+    int unionSize() const { return onlyFirst + onlySecond + common; }
+};
+
+// Reads one or two sorted lists (black and red neighbours) as a single sorted sequence
+class SortedListsCursor {
+public:
+    explicit SortedListsCursor(const std::vector<int>& first)
+        : a(first.data()), aEnd(first.data() + first.size()), b(nullptr), bEnd(nullptr) {}
+
+    SortedListsCursor(const std::vector<int>& first, const std::vector<int>& second)
+        : a(first.data()), aEnd(first.data() + first.size()),
+          b(second.data()), bEnd(second.data() + second.size()) {}
+
+    bool done() const { return a == aEnd && b == bEnd; }
+
+    int get() const {
+        if (b == bEnd) return *a;
+        if (a == aEnd) return *b;
+        return *a < *b ? *a : *b;
+    }
+
+    void next() {
+        if (b == bEnd) { ++a; return; }
+        if (a == aEnd) { ++b; return; }
+        if (*a < *b) ++a;
+        else if (*b < *a) ++b;
+        else { ++a; ++b; }
+    }
+
+private:
+    const int* a;
+    const int* aEnd;
+    const int* b;
+    const int* bEnd;
+};
+
+// Cursors expose done()/get()/next() and yield strictly increasing vertices.
+// exclude1/exclude2 are left out of every count (usually the pair being scored).
+template <typename CursorA, typename CursorB>
+MergeCounts countMerge(CursorA first, CursorB second, int exclude1 = -1, int exclude2 = -1) {
+    MergeCounts counts;
+    while (!first.done() && !second.done()) {
+        int x = first.get();
+        int y = second.get();
+        if (x == y) {
+            if (x != exclude1 && x != exclude2) counts.common++;
+            first.next();
+            second.next();
+        } else if (x < y) {
+            if (x != exclude1 && x != exclude2) counts.onlyFirst++;
+            first.next();
+        } else {
+            if (y != exclude1 && y != exclude2) counts.onlySecond++;
+            second.next();
+        }
+    }
+    for (; !first.done(); first.next()) {
+        int x = first.get();
+        if (x != exclude1 && x != exclude2) counts.onlyFirst++;
+    }
+    for (; !second.done(); second.next()) {
+        int y = second.get();
+        if (y != exclude1 && y != exclude2) counts.onlySecond++;
+    }
+    return counts;
+}
+
+#endif // NEIGHBORHOODKERNELS_HPP
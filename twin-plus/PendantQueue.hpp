@@ -0,0 +1,60 @@
+#ifndef PENDANTQUEUE_HPP
+#define PENDANTQUEUE_HPP
+
+#include <vector>
+
+inline bool pendantReduction = true; // contract leaves with a common neighbour inside the heuristic loops
+
+// Leaves (vertices of degree 1, black and red edges together) waiting to be paired with
+// another leaf of the same neighbour. Two such leaves are twins up to the colour of their
+// edge: merging them keeps the edge to the neighbour, red if either one was, so the merged
+// vertex has red degree at most 1 (which a red leaf had already) and the neighbour's red
+// degree can only go down; the width never grows. The graph pushes a vertex whenever its
+// degree bucket changes to 1; entries are checked again when drained, so stale ones (the
+// vertex died or got another edge since) cost one test. Every parent remembers one leaf,
+// which makes each drained vertex O(1) on top of its merge.
+class PendantQueue {
+public:
+    void reset(int numVertices) {
+        queued.assign(numVertices, 0);
+        leafOf.assign(numVertices, -1);
+        pending.clear();
+    }
+
+    void push(int vertex) {
+        if (queued[vertex]) return;
+        queued[vertex] = 1;
+        pending.push_back(vertex);
+    }
+
+    // parentOf(v) is the single neighbour of a leaf v and -1 for anything else,
+    // merge(leaf, v) contracts v into leaf. Merges may push further leaves (the parent
+    // itself once its last other neighbour is gone), those are drained as well.
+    // Returns the number of merges.
+    template <typename ParentOf, typename Merge>
+    int drain(ParentOf parentOf, Merge merge) {
+        int merges = 0;
+        while (!pending.empty()) {
+            int v = pending.back();
+            pending.pop_back();
+            queued[v] = 0;
+            int parent = parentOf(v);
+            if (parent < 0) continue;
+            int& leaf = leafOf[parent];
+            if (leaf >= 0 && leaf != v && parentOf(leaf) == parent) {
+                merge(leaf, v);
+                merges++;
+            } else {
+                leaf = v;
+            }
+        }
+        return merges;
+    }
+
+private:
+    std::vector<char> queued;
+    std::vector<int> leafOf; // last leaf seen per parent, may be stale
+    std::vector<int> pending;
+};
+
+#endif // PENDANTQUEUE_HPP
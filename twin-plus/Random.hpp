@@ -0,0 +1,63 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+#include <limits>
+
+// xoshiro256** (Blackman and Vigna): 32 bytes of state and a few shifts per number, where
+// mt19937 carries 2.5 KB and random_device may be a system call. Meets the requirements
+// of a UniformRandomBitGenerator, so std::shuffle and the distributions accept it too.
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256(std::uint64_t value = 12345) {
+        seed(value);
+    }
+
+    // The state is filled by splitmix64, which never leaves it all zero
+    void seed(std::uint64_t value) {
+        for (std::uint64_t& word : state) {
+            value += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = value;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() {
+        std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, bound) by a multiply-shift of the high 32 bits (Lemire), no division;
+    // the bias is below bound / 2^32, far under anything a degree can show
+    std::uint32_t below(std::uint32_t bound) {
+        return static_cast<std::uint32_t>(((*this)() >> 32) * bound >> 32);
+    }
+
+private:
+    std::uint64_t state[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+#endif // RANDOM_HPP
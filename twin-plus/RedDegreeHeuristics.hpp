@@ -0,0 +1,124 @@
+#ifndef REDDEGREEHEURISTICS_HPP
+#define REDDEGREEHEURISTICS_HPP
+
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ContractionSequence.hpp"
+#include "ScoreCache.hpp"
+#include "Telemetry.hpp"
+
+// The greedy red degree heuristics, written once for both graph backends. Graph and CsrGraph
+// forward their findRedDegreeContraction* members here; GraphT provides
+//   getVertices, getVertexId, getWidth, getPrintProgress, searchAborted,
+//   getTopNVerticesWithLowestRedDegree, getRandomVertices, getRandomWalkVertices,
+//   getCachedScore, scoreCandidatePairs, reducePendants and mergeVertices.
+// Every iteration contracts the best scored candidate pair, ties go to the pair seen first.
+class RedDegreeHeuristics {
+public:
+    // Scores all pairs of the 20 vertices with the lowest red degree, 20 random ones the
+    // first time round
+    template <typename GraphT>
+    static ContractionSequence lowestPairs(GraphT& g) {
+        ContractionSequence contractionSequence;
+        ScoreCache scores;
+        std::vector<std::pair<int, int>> candidatePairs;
+        std::vector<int> candidateScores;
+
+        bool firstIteration = true;
+        while (g.getVertices().size() > 1 && !g.searchAborted()) {
+            g.reducePendants(contractionSequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = firstIteration ? g.getRandomVertices(20)
+                                                                   : g.getTopNVerticesWithLowestRedDegree(20);
+            firstIteration = false;
+
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+            g.scoreCandidatePairs(scores, lowestDegreeVertices, candidatePairs, candidateScores);
+            for (std::size_t k = 0; k < candidatePairs.size(); k++) {
+                if (candidateScores[k] < bestScore) {
+                    bestScore = candidateScores[k];
+                    bestPair = candidatePairs[k];
+                }
+            }
+
+            contractionSequence.add(g.getVertexId(bestPair.first) + 1, g.getVertexId(bestPair.second) + 1);
+            g.mergeVertices(bestPair.first, bestPair.second);
+
+            if (g.getPrintProgress() && telemetry.progressDue()) {
+                std::cout << "c (Merged ( " << bestPair.first << "," << bestPair.second << "), left " << g.getVertices().size()
+                          << ", tww: " << g.getWidth() << ") Cycle in " << cycleTime(start) << " seconds" << "\n";
+            }
+        }
+        return contractionSequence;
+    }
+
+    // Pairs each of the two lowest red degree vertices with up to 105 vertices reached by
+    // random walks of one or two steps
+    template <typename GraphT>
+    static ContractionSequence randomWalk(GraphT& g) {
+        ContractionSequence contractionSequence;
+        ScoreCache scores;
+
+        while (g.getVertices().size() > 1 && !g.searchAborted()) {
+            g.reducePendants(contractionSequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = g.getTopNVerticesWithLowestRedDegree(2);
+
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+            auto scoreStart = std::chrono::steady_clock::now();
+            int candidates = 0;
+
+            for (std::size_t i = 0; i < lowestDegreeVertices.size(); i++) {
+                int v1 = lowestDegreeVertices[i];
+                std::set<int> randomWalkVertices = g.getRandomWalkVertices(v1, 105);
+                candidates += randomWalkVertices.size();
+
+                for (int v2 : randomWalkVertices) {
+                    if (v2 > v1) {
+                        std::swap(v1, v2);
+                    }
+
+                    int score = g.getCachedScore(scores, v1, v2);
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v1, v2};
+                    }
+                }
+            }
+            telemetry.record(Telemetry::CANDIDATES, candidates);
+            telemetry.record(Telemetry::SCORE_NS, Telemetry::nanosecondsSince(scoreStart));
+
+            contractionSequence.add(g.getVertexId(bestPair.first) + 1, g.getVertexId(bestPair.second) + 1);
+            g.mergeVertices(bestPair.first, bestPair.second);
+
+            if (g.getPrintProgress() && telemetry.progressDue()) {
+                std::cout << "c (Left " << g.getVertices().size() << ", tww: " << g.getWidth()
+                          << ") Cycle in " << cycleTime(start) << " seconds" << "\n";
+            }
+        }
+        return contractionSequence;
+    }
+
+private:
+    // Seconds since start as the progress lines print them, "s.000000mmm"
+    static std::string cycleTime(std::chrono::high_resolution_clock::time_point start) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+        std::ostringstream text;
+        text << elapsed.count() / 1000 << "." << std::setfill('0') << std::setw(9) << elapsed.count() % 1000;
+        return text.str();
+    }
+};
+
+#endif // REDDEGREEHEURISTICS_HPP
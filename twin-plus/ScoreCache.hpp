@@ -0,0 +1,57 @@
+#ifndef SCORECACHE_HPP
+#define SCORECACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <unordered_dense.h>
+
+// Pair scores that survive across contraction steps. Every entry remembers the
+// neighbourhood versions of both endpoints at the time it was computed; mergeVertices
+// bumps the version of each vertex whose neighbourhood it changes, which silently
+// invalidates exactly the pairs touching those vertices.
+class ScoreCache {
+public:
+    explicit ScoreCache(std::size_t maxEntries = 10000000) : maxEntries(maxEntries) {}
+
+    bool find(int v1, int v2, const std::vector<unsigned>& versions, int& score) const {
+        if (v1 > v2) std::swap(v1, v2);
+        auto it = entries.find(key(v1, v2));
+        if (it == entries.end()) return false;
+        if (it->second.firstVersion != versions[v1] || it->second.secondVersion != versions[v2]) return false;
+        score = it->second.score;
+        return true;
+    }
+
+    void store(int v1, int v2, const std::vector<unsigned>& versions, int score) {
+        if (v1 > v2) std::swap(v1, v2);
+        // Stale entries are only overwritten lazily, drop everything once the map gets too big
+        if (entries.size() >= maxEntries) entries.clear();
+        entries[key(v1, v2)] = {score, versions[v1], versions[v2]};
+    }
+
+    void clear() {
+        entries.clear();
+    }
+
+    std::size_t size() const {
+        return entries.size();
+    }
+
+private:
+    struct Entry {
+        int score;
+        unsigned firstVersion;
+        unsigned secondVersion;
+    };
+
+    ankerl::unordered_dense::map<std::uint64_t, Entry> entries;
+    std::size_t maxEntries;
+
+    static std::uint64_t key(int v1, int v2) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(v1)) << 32) | static_cast<std::uint32_t>(v2);
+    }
+};
+
+#endif // SCORECACHE_HPP
@@ -0,0 +1,51 @@
+#ifndef SEARCHCONTROL_HPP
+#define SEARCHCONTROL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+
+// Shared by all runs racing on one component: the best complete width found so
+// far and a wall clock deadline. A run whose current width already reaches the
+// bound can not produce a better sequence anymore, since the width of a partial
+// contraction never goes down, so it stops like prevSolution pruning does.
+// With a lower bound attached (see LowerBound.hpp) every run also stops once the
+// best width reaches it, no sequence can do better than that.
+class SearchControl {
+public:
+    explicit SearchControl(std::chrono::steady_clock::time_point deadline) : deadline(deadline) {}
+
+    int bound() const {
+        return best.load(std::memory_order_relaxed);
+    }
+
+    // Lowers the bound to width if that is an improvement
+    void offer(int width) {
+        int current = best.load(std::memory_order_relaxed);
+        while (width < current && !best.compare_exchange_weak(current, width, std::memory_order_relaxed)) {}
+    }
+
+    bool expired() const {
+        return std::chrono::steady_clock::now() >= deadline;
+    }
+
+    // value is raised by another thread while the runs read it
+    void setLowerBound(const std::atomic<int>* value) {
+        lowerBound = value;
+    }
+
+    bool solved() const {
+        return lowerBound != nullptr && bound() <= lowerBound->load(std::memory_order_relaxed);
+    }
+
+    bool shouldStop(int width) const {
+        return width >= bound() || solved() || expired();
+    }
+
+private:
+    std::atomic<int> best{INT_MAX};
+    const std::atomic<int>* lowerBound = nullptr;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+#endif // SEARCHCONTROL_HPP
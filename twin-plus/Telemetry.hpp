@@ -0,0 +1,119 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// Run-wide counters and log2 histograms for the contraction loops. Every thread writes
+// to its own shard with plain increments, nothing is shared on the hot path; the shards
+// are only summed up for the summary, after the workers are done. progressDue() rate
+// limits the per-iteration "c" lines, so stdout is no longer flushed on every merge.
+class Telemetry {
+public:
+    enum Counter { MERGES, CACHE_HITS, CACHE_MISSES, PENDANT_MERGES, NUM_COUNTERS };
+    enum Histogram { MERGE_NS, SCORE_NS, CANDIDATES, NUM_HISTOGRAMS };
+
+    static constexpr int NUM_BUCKETS = 65; // bucket b holds values in [2^(b-1), 2^b), bucket 0 holds 0
+
+    void count(Counter counter, std::uint64_t amount = 1) {
+        shard().counters[counter] += amount;
+    }
+
+    void record(Histogram histogram, std::uint64_t value) {
+        Shard& s = shard();
+        s.buckets[histogram][bucketOf(value)]++;
+        s.sums[histogram] += value;
+        if (value > s.maxima[histogram]) s.maxima[histogram] = value;
+    }
+
+    static std::uint64_t nanosecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // True at most once per progressInterval on the calling thread (always on its first call)
+    bool progressDue() {
+        Shard& s = shard();
+        auto now = std::chrono::steady_clock::now();
+        if (s.progressPrinted && now - s.lastProgress < progressInterval) return false;
+        s.progressPrinted = true;
+        s.lastProgress = now;
+        return true;
+    }
+
+    void setProgressInterval(std::chrono::milliseconds interval) {
+        progressInterval = interval;
+    }
+
+    // One JSON object: counters, cache hit rate and per histogram count/sum/max plus
+    // the log2 buckets up to the highest non-empty one
+    void writeSummary(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Shard total;
+        for (const std::unique_ptr<Shard>& s : shards) {
+            for (int c = 0; c < NUM_COUNTERS; c++) total.counters[c] += s->counters[c];
+            for (int h = 0; h < NUM_HISTOGRAMS; h++) {
+                for (int b = 0; b < NUM_BUCKETS; b++) total.buckets[h][b] += s->buckets[h][b];
+                total.sums[h] += s->sums[h];
+                if (s->maxima[h] > total.maxima[h]) total.maxima[h] = s->maxima[h];
+            }
+        }
+
+        const char* counterNames[NUM_COUNTERS] = {"merges", "cache_hits", "cache_misses", "pendant_merges"};
+        const char* histogramNames[NUM_HISTOGRAMS] = {"merge_ns", "score_ns", "candidates"};
+        std::uint64_t lookups = total.counters[CACHE_HITS] + total.counters[CACHE_MISSES];
+
+        out << "{\"threads\":" << shards.size();
+        for (int c = 0; c < NUM_COUNTERS; c++) out << ",\"" << counterNames[c] << "\":" << total.counters[c];
+        out << ",\"cache_hit_rate\":" << (lookups > 0 ? double(total.counters[CACHE_HITS]) / lookups : 0.0);
+        for (int h = 0; h < NUM_HISTOGRAMS; h++) {
+            std::uint64_t samples = 0;
+            int highest = 0;
+            for (int b = 0; b < NUM_BUCKETS; b++) {
+                samples += total.buckets[h][b];
+                if (total.buckets[h][b] != 0) highest = b;
+            }
+            out << ",\"" << histogramNames[h] << "\":{\"count\":" << samples << ",\"sum\":" << total.sums[h]
+                << ",\"max\":" << total.maxima[h] << ",\"log2_buckets\":[";
+            for (int b = 0; b <= highest; b++) out << (b > 0 ? "," : "") << total.buckets[h][b];
+            out << "]}";
+        }
+        out << "}\n";
+    }
+
+private:
+    struct Shard {
+        std::uint64_t counters[NUM_COUNTERS] = {};
+        std::uint64_t buckets[NUM_HISTOGRAMS][NUM_BUCKETS] = {};
+        std::uint64_t sums[NUM_HISTOGRAMS] = {};
+        std::uint64_t maxima[NUM_HISTOGRAMS] = {};
+        std::chrono::steady_clock::time_point lastProgress;
+        bool progressPrinted = false;
+    };
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Shard>> shards; // outlive their threads, summed by writeSummary
+    std::chrono::milliseconds progressInterval{1000};
+
+    static int bucketOf(std::uint64_t value) {
+        return value == 0 ? 0 : 64 - __builtin_clzll(value);
+    }
+
+    // There is a single Telemetry object, so one thread_local pointer per thread suffices
+    Shard& shard() {
+        thread_local Shard* local = nullptr;
+        if (local == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            shards.push_back(std::make_unique<Shard>());
+            local = shards.back().get();
+        }
+        return *local;
+    }
+};
+
+inline Telemetry telemetry;
+
+#endif // TELEMETRY_HPP
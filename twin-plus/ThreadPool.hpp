@@ -0,0 +1,105 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data parallel loops. parallelFor hands out
+// indices through a shared counter, the calling thread works along and the call
+// returns once every index has been processed. A call made while another one is
+// still running (e.g. from a different component solver) runs on the caller
+// alone instead of waiting for the workers. Build with -pthread.
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads) {
+        for (int i = 1; i < numThreads; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeWorkers.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const {
+        return static_cast<int>(workers.size()) + 1;
+    }
+
+    // Calls fn(i) for every i in [0, count). fn must only write to state owned by index i.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+        if (count == 0) return;
+        std::unique_lock<std::mutex> busyLock(busy, std::try_to_lock);
+        if (workers.empty() || count == 1 || !busyLock.owns_lock()) {
+            for (std::size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        task = &fn;
+        taskSize = count;
+        nextIndex.store(0);
+        activeWorkers = static_cast<int>(workers.size());
+        generation++;
+        lock.unlock();
+        wakeWorkers.notify_all();
+
+        runTask(fn, count);
+
+        lock.lock();
+        workersDone.wait(lock, [this] { return activeWorkers == 0; });
+        task = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex busy;
+    std::mutex mutex;
+    std::condition_variable wakeWorkers;
+    std::condition_variable workersDone;
+    const std::function<void(std::size_t)>* task = nullptr;
+    std::size_t taskSize = 0;
+    std::atomic<std::size_t> nextIndex{0};
+    unsigned long generation = 0;
+    int activeWorkers = 0;
+    bool stopping = false;
+
+    void runTask(const std::function<void(std::size_t)>& fn, std::size_t count) {
+        for (std::size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+            fn(i);
+        }
+    }
+
+    void workerLoop() {
+        unsigned long seenGeneration = 0;
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeWorkers.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+            const std::function<void(std::size_t)>* fn = task;
+            std::size_t count = taskSize;
+            lock.unlock();
+
+            runTask(*fn, count);
+
+            lock.lock();
+            if (--activeWorkers == 0) workersDone.notify_one();
+        }
+    }
+};
+
+#endif // THREADPOOL_HPP
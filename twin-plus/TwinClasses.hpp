@@ -0,0 +1,94 @@
+#ifndef TWINCLASSES_HPP
+#define TWINCLASSES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <unordered_dense.h>
+
+// Groups vertices with equal neighbourhoods: open ones (false twins, N(u) = N(v)) or
+// closed ones (true twins, N[u] = N[v]). Every neighbourhood is hashed as the sum of
+// per-vertex keys, which does not depend on the order of the neighbours, so sorted lists
+// and hash sets work alike. A vertex only joins a class after a check against the class
+// representative, so hash collisions never merge non-twins. One pass over all adjacency
+// lists plus one check per vertex with an adjacency test per neighbour.
+class TwinClasses {
+public:
+    // neighbors(v) is iterable, adjacent(u, v) tests an edge. Returns the classes with
+    // at least two vertices, each in the order its vertices appear in vertices.
+    template <typename Neighbors, typename Adjacent>
+    static std::vector<std::vector<int>> find(const std::vector<int>& vertices, Neighbors neighbors,
+                                              Adjacent adjacent, bool closed) {
+        std::vector<std::vector<int>> classes;
+        std::vector<std::size_t> classDegrees; // of the representative, classes[c].front()
+        ankerl::unordered_dense::map<std::uint64_t, std::vector<int>> classesByHash;
+        for (int v : vertices) {
+            std::uint64_t hash = closed ? key(v) : 0;
+            std::size_t degree = 0;
+            for (int u : neighbors(v)) {
+                hash += key(u);
+                degree++;
+            }
+            std::vector<int>& candidates = classesByHash[hash];
+            int found = -1;
+            for (int c : candidates) {
+                if (classDegrees[c] == degree && sameNeighborhood(classes[c].front(), v, neighbors, adjacent, closed)) {
+                    found = c;
+                    break;
+                }
+            }
+            if (found >= 0) {
+                classes[found].push_back(v);
+            } else {
+                candidates.push_back(classes.size());
+                classes.push_back({v});
+                classDegrees.push_back(degree);
+            }
+        }
+
+        std::vector<std::vector<int>> twins;
+        for (std::vector<int>& members : classes) {
+            if (members.size() > 1) twins.push_back(std::move(members));
+        }
+        return twins;
+    }
+
+    static constexpr int MAX_ROUNDS = 16;
+
+    // Contracts false twins, then true twins, round after round until a round finds neither,
+    // since contracting one kind can create the other: a cograph only collapses to one vertex
+    // after as many rounds as its cotree is deep. Every round is linear, MAX_ROUNDS bounds the
+    // deep cases. contract(trueTwins) merges one kind and returns whether it merged anything,
+    // rounds only start while more() holds.
+    template <typename Contract, typename More>
+    static void reduce(Contract contract, More more) {
+        for (int round = 0; round < MAX_ROUNDS && more(); round++) {
+            bool falseTwins = contract(false);
+            bool trueTwins = contract(true);
+            if (!falseTwins && !trueTwins) break;
+        }
+    }
+
+private:
+    // splitmix64 finalizer, spreads consecutive ids over all 64 bits
+    static std::uint64_t key(int v) {
+        std::uint64_t x = static_cast<std::uint64_t>(v) + 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // With equal degrees, N(v) minus r inside N(r) makes the neighbourhoods equal; closed
+    // ones also need r and v adjacent (then N(r) holds v, and r is skipped in N(v))
+    template <typename Neighbors, typename Adjacent>
+    static bool sameNeighborhood(int r, int v, Neighbors& neighbors, Adjacent& adjacent, bool closed) {
+        if (closed && !adjacent(r, v)) return false;
+        for (int u : neighbors(v)) {
+            if (u == r && closed) continue;
+            if (!adjacent(r, u)) return false;
+        }
+        return true;
+    }
+};
+
+#endif // TWINCLASSES_HPP
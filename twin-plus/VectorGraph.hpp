@@ -0,0 +1,1575 @@
+#ifndef VECTORGRAPH_HPP
+#define VECTORGRAPH_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <set>
+#include <limits.h>
+#include <random>
+#include <chrono>
+#include <iomanip> 
+#include <unordered_dense.h>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <cmath>
+#include <thread>
+#include "BitsetAdjacency.hpp"
+#include "BucketQueue.hpp"
+#include "ContractionSequence.hpp"
+#include "ComponentSplitter.hpp"
+#include "CsrAdjacency.hpp"
+#include "MinHashIndex.hpp"
+#include "NeighborhoodKernels.hpp"
+#include "PendantQueue.hpp"
+#include "Random.hpp"
+#include "RedDegreeHeuristics.hpp"
+#include "ScoreCache.hpp"
+#include "SearchControl.hpp"
+#include "Telemetry.hpp"
+#include "ThreadPool.hpp"
+#include "TwinClasses.hpp"
+
+// Graph, the sorted adjacency vector backend of solver-vectors, and the structs its
+// heuristics return.
+
+const int SCORE_RESET_THRESHOLD = 10000000;
+inline int cnt = 0; // vertices visited by dfs
+inline bool useBitsetScores = true; // XOR + popcount getScore for components that fit BitsetAdjacency
+inline int numThreads = std::max(1, (int)std::thread::hardware_concurrency()); // workers scoring candidate pairs and solving components, needs -pthread
+const int PARALLEL_SCORE_MIN_PAIRS = 64; // fewer uncached pairs than this are scored on the calling thread
+
+struct PairHash {
+    template <class T1, class T2>
+    std::size_t operator() (const std::pair<T1, T2>& p) const {
+        auto h1 = std::hash<T1>{}(p.first);
+        auto h2 = std::hash<T2>{}(p.second);
+        return h1 ^ h2;
+    }
+};
+
+struct ContractionStep {
+    int iteration;
+    std::pair<int, int> vertexPair;
+    int score;
+    int width;
+};
+
+struct ComponentSolution {
+    ContractionSequence sequence;
+    std::vector<ContractionStep> contractionSteps;
+    int width = 0;
+};
+
+// Effect of merging a pair, see Graph::predictMerge
+struct MergePrediction {
+    int redDegree = 0;            // red degree of the merged vertex
+    int maxNeighborIncrease = 0;  // largest red degree increase of a neighbour (0 or 1)
+    int maxNeighborRedDegree = 0; // largest red degree of a neighbour after the merge
+    int width = 0;                // getWidth() after the merge, what getRealScore returns
+};
+
+// One undoable change made while a trail is open, see Graph::startTrail
+enum class TrailOp { AddBlack, AddRed, RemoveBlack, RemoveRed, RedBucket, DegreeBucket, RemoveVertex, Width };
+
+struct TrailEntry {
+    TrailOp op;
+    int a; // edge endpoint / vertex / old width
+    int b; // edge endpoint / old bucket key / index in vertices
+    int c; // neighbour bit flipped by the edge change / predecessor in the old bucket
+};
+
+class Graph {
+private:
+    std::vector<int> vertices;
+    std::vector<int> ids; // mapping id -> index, used for connected components
+    std::vector<std::vector<int>> adjListBlack;  // For black edges, kept sorted
+    std::vector<std::vector<int>> adjListRed;    // For red edges, kept sorted
+    BucketQueue redDegreeToVertices; // vertices keyed by red degree
+    BucketQueue degreeToVertices; // vertices keyed by black + red degree, filled by updateBlackDegrees
+    PendantQueue pendants; // fed by updateVertexDegree, drained by reducePendants
+    std::vector<unsigned> neighborhoodVersion; // bumped whenever mergeVertices changes N(v), validates ScoreCache entries
+    BitsetAdjacency neighborBits; // mirrors black + red edges while bitsetScoresEnabled
+    bool bitsetScoresEnabled = false;
+    int width = 0;
+    Xoshiro256 gen;
+    bool useFixedSeed = true;
+    bool printProgress = true; // per-iteration "c" lines, off while components are solved concurrently
+    std::vector<TrailEntry> trail; // changes since the outermost open startTrail
+    std::vector<char> openTrials; // per open trail, innermost last: whether startTrail was a trial
+    int trialDepth = 0; // open trial trails, pendant pushes are held back while there are any
+    const SearchControl* searchControl = nullptr; // portfolio runs stop early through it, not copied
+    ThreadPool* scorePool = nullptr; // owned by solve(), spreads scoreCandidatePairs misses, not copied
+
+public:
+    Graph() {
+        if(useFixedSeed) {
+            gen.seed(12345);
+        } else {
+            std::random_device rd;
+            gen.seed(rd());
+        }
+    }
+
+    Graph(const Graph &g) : gen(12345) {
+        this->vertices = g.vertices;
+        this->ids = g.ids;
+        this->adjListBlack = g.adjListBlack;
+        this->adjListRed = g.adjListRed;
+        this->redDegreeToVertices = g.redDegreeToVertices;
+        this->degreeToVertices = g.degreeToVertices;
+        this->pendants = g.pendants;
+        this->neighborhoodVersion = g.neighborhoodVersion;
+        this->neighborBits = g.neighborBits;
+        this->bitsetScoresEnabled = g.bitsetScoresEnabled && this->neighborBits.allocated(); // lists when over budget
+        this->width = g.width;
+        this->printProgress = g.printProgress;
+
+        if(useFixedSeed) {
+            gen.seed(12345);
+        } else {
+            std::random_device rd;
+            gen.seed(rd());
+        }
+    }
+
+    // Moves keep everything, the seed included; splitComponents hands a whole graph over this way
+    Graph(Graph&& g) = default;
+    Graph& operator=(Graph&& g) = default;
+
+    // Copies through the copy constructor and moves the result in, so assignment also leaves
+    // the trail, searchControl and the generator state behind
+    Graph& operator=(const Graph& g) {
+        if (this != &g) *this = Graph(g);
+        return *this;
+    }
+
+    void updateDegrees(int v){
+        updateVertexRedDegree(v, 0);
+        updateVertexDegree(v, 0);
+    }
+
+    int getVertexId(int v){
+        return ids[v];
+    }
+        
+    // Adds n vertices to the graph numbered from 0 to n-1
+    void addVertices(int n){
+        vertices.resize(n);
+        adjListBlack.resize(n);
+        adjListRed.resize(n);
+        neighborhoodVersion.resize(n);
+
+        std::iota(vertices.begin(), vertices.end(), 0); // populate vertices with 0...n-1
+        redDegreeToVertices.reset(n);
+        degreeToVertices.reset(n);
+        pendants.reset(n);
+        for (int v : vertices) redDegreeToVertices.push(v, 0);
+    }
+
+    void addVertices(int n, std::vector<int> ids){
+        adjListBlack.resize(n);
+        adjListRed.resize(n);
+        vertices.resize(n);
+        neighborhoodVersion.resize(n);
+
+        this->ids = ids;
+        std::iota(vertices.begin(), vertices.end(), 0); // populate vertices with 0...n-1
+        redDegreeToVertices.reset(n);
+        degreeToVertices.reset(n);
+        pendants.reset(n);
+        for (int v : vertices) redDegreeToVertices.push(v, 0);
+    }
+
+    void setIds(std::vector<int> values) {
+        ids = values;
+    }
+
+    // Heuristics that check searchAborted() return a partial sequence once control says so
+    void setSearchControl(const SearchControl* control) {
+        searchControl = control;
+    }
+
+    // scoreCandidatePairs scores its cache misses on pool, or on the calling thread without one
+    void setScorePool(ThreadPool* pool) {
+        scorePool = pool;
+    }
+
+    void reseed(unsigned seed) {
+        gen.seed(seed);
+    }
+
+    void setPrintProgress(bool enabled) {
+        printProgress = enabled;
+    }
+
+    bool getPrintProgress() const {
+        return printProgress;
+    }
+
+    void addEdgeBegin(int v1, int v2) {
+        if (v1 < v2) {
+            adjListBlack[v2].push_back(v1);
+            adjListBlack[v1].push_back(v2);
+        }
+    }
+
+    // Bulk alternative to addEdgeBegin, the rows of csr are sorted and free of duplicates already
+    void setBlackAdjacency(const CsrAdjacency& csr) {
+        for (int v = 0; v < csr.numVertices(); ++v) {
+            adjListBlack[v].assign(csr.targets.begin() + csr.offsets[v], csr.targets.begin() + csr.offsets[v + 1]);
+        }
+    }
+
+    // Black edges between the vertices left, relabelled to 0..size-1 in vertex order. Until a
+    // merge creates a red edge (twin contractions never do) this is an induced subgraph of the input.
+    CsrAdjacency blackAdjacency() const {
+        std::vector<int> localIndex(adjListBlack.size(), -1);
+        for (std::size_t i = 0; i < vertices.size(); ++i) localIndex[vertices[i]] = i;
+        CsrAdjacency csr;
+        csr.offsets.reserve(vertices.size() + 1);
+        csr.offsets.push_back(0);
+        for (int v : vertices) {
+            for (int u : adjListBlack[v]) csr.targets.push_back(localIndex[u]);
+            csr.offsets.push_back(csr.targets.size());
+        }
+        return csr;
+    }
+
+    // Graph keeps explicit lists, so the complement is built here; CsrGraph answers it implicitly
+    void setComplementAdjacency(const CsrAdjacency& csr) {
+        setBlackAdjacency(csr.complement(numThreads));
+    }
+
+    // Also restores the sorted order of the lists filled by addEdgeBegin
+    void updateBlackDegrees() {
+        for (int i = 0; i < adjListBlack.size(); ++i) {
+            std::sort(adjListBlack[i].begin(), adjListBlack[i].end());
+            degreeToVertices.push(i, adjListBlack[i].size());
+            if (adjListBlack[i].size() == 1) pendants.push(i);
+        }
+    }
+
+    // Builds the dense neighbourhood matrix used by getScore, skipped for graphs that do not fit
+    // and once the process-wide BitsetAdjacency budget is used up.
+    // Not part of updateBlackDegrees: solve() builds it per component, inside the run that needs it.
+    // Does nothing while the matrix is there already.
+    void enableBitsetScores() {
+        if (bitsetScoresEnabled) return;
+        bitsetScoresEnabled = neighborBits.allocate(adjListBlack.size());
+        if (!bitsetScoresEnabled) return;
+        for (std::size_t v = 0; v < adjListBlack.size(); ++v) {
+            for (int neighbor : adjListBlack[v]) neighborBits.addEdge(v, neighbor);
+            for (int neighbor : adjListRed[v]) neighborBits.addEdge(v, neighbor);
+        }
+    }
+
+    // Frees the matrix, getScore goes back to the adjacency lists
+    void disableBitsetScores() {
+        bitsetScoresEnabled = false;
+        neighborBits.release();
+    }
+
+    void addEdge(int v1, int v2, const std::string& color = "black") {
+        if (color == "black" && !containsSorted(adjListBlack[v1], v2)) {
+            updateVertexDegree(v1, 1);
+            updateVertexDegree(v2, 1);
+            insertSorted(adjListBlack[v1], v2);
+            insertSorted(adjListBlack[v2], v1);
+            bool bitFlipped = bitsetScoresEnabled && !neighborBits.hasEdge(v1, v2);
+            if (bitFlipped) neighborBits.addEdge(v1, v2);
+            record(TrailOp::AddBlack, v1, v2, bitFlipped);
+        } else if (color == "red" && !containsSorted(adjListRed[v1], v2)) {
+            updateVertexDegree(v1, 1);
+            updateVertexDegree(v2, 1);
+            updateVertexRedDegree(v1, 1);
+            updateVertexRedDegree(v2, 1);
+            insertSorted(adjListRed[v1], v2);
+            insertSorted(adjListRed[v2], v1);
+            bool bitFlipped = bitsetScoresEnabled && !neighborBits.hasEdge(v1, v2);
+            if (bitFlipped) neighborBits.addEdge(v1, v2);
+            record(TrailOp::AddRed, v1, v2, bitFlipped);
+        }
+    }
+
+    void removeEdge(int v1, int v2) {
+        if (containsSorted(adjListBlack[v1], v2)) {
+            // order matters since updateVertexDegree uses adjListBlack's state
+            updateVertexDegree(v1, -1);
+            updateVertexDegree(v2, -1);
+            eraseSorted(adjListBlack[v1], v2);
+            eraseSorted(adjListBlack[v2], v1);
+            // mergeVertices can briefly hold a pair as black and red at once, the bit stays while the red edge does
+            bool bitFlipped = bitsetScoresEnabled && !containsSorted(adjListRed[v1], v2);
+            if (bitFlipped) {
+                neighborBits.removeEdge(v1, v2);
+            }
+            record(TrailOp::RemoveBlack, v1, v2, bitFlipped);
+        } else if (containsSorted(adjListRed[v1], v2)) {
+            updateVertexDegree(v1, -1);
+            updateVertexDegree(v2, -1);
+            updateVertexRedDegree(v1, -1);
+            updateVertexRedDegree(v2, -1);
+            eraseSorted(adjListRed[v1], v2);
+            eraseSorted(adjListRed[v2], v1);
+            if (bitsetScoresEnabled) neighborBits.removeEdge(v1, v2);
+            record(TrailOp::RemoveRed, v1, v2, bitsetScoresEnabled);
+        }
+    }
+
+    void removeVertex(int vertex) {        
+        // Remove the vertex from the black adjacency list and update neighbors
+        if (!adjListBlack[vertex].empty()) {
+            std::vector<int> neighbors = adjListBlack[vertex];
+            for (int neighbor : neighbors) {
+                removeEdge(neighbor, vertex);
+            }
+        }
+        
+        // Remove the vertex from the red adjacency list and update neighbors
+        if (!adjListRed[vertex].empty()) {
+            std::vector<int> neighbors = adjListRed[vertex];
+            for (int neighbor : neighbors) {
+                removeEdge(neighbor, vertex);
+            }
+        }
+        
+        // vertices stays sorted: filled by iota, only erased from and restored in place by rollback
+        auto position = std::lower_bound(vertices.begin(), vertices.end(), vertex);
+        record(TrailOp::RemoveVertex, vertex, position - vertices.begin());
+        vertices.erase(position);
+        record(TrailOp::RedBucket, vertex, redDegreeToVertices.key(vertex), redDegreeToVertices.before(vertex));
+        redDegreeToVertices.erase(vertex);
+        record(TrailOp::DegreeBucket, vertex, degreeToVertices.key(vertex), degreeToVertices.before(vertex));
+        degreeToVertices.erase(vertex);
+    }
+
+    int getWidth() const {
+        return width;
+    }
+
+    bool searchAborted() const {
+        return searchControl != nullptr && searchControl->shouldStop(width);
+    }
+
+    const std::vector<int>& getVertices() const {
+        return vertices;
+    }
+
+    std::vector<int> getIds() {
+        return this->ids;
+    }
+
+    // Components of the uncontracted (all black) graph, each relabelled to 0..size-1 with
+    // ids mapping back to this graph's ids. One BFS pass and one sweep over the rows, see
+    // ComponentSplitter. A graph with a single component is moved into the result as is.
+    std::vector<Graph> splitComponents() && {
+        auto forEachNeighbor = [&](int v, auto visit) {
+            for (int u : adjListBlack[v]) visit(u);
+        };
+        ComponentSplitter splitter(adjListBlack.size(), forEachNeighbor);
+        std::vector<Graph> result;
+        if (splitter.numComponents() == 1) {
+            result.push_back(std::move(*this));
+            return result;
+        }
+
+        std::vector<std::vector<int>> members = splitter.members();
+        std::vector<CsrAdjacency> slices = splitter.slices(forEachNeighbor);
+        result.resize(members.size());
+        for (std::size_t c = 0; c < members.size(); ++c) {
+            int size = members[c].size();
+            for (int& v : members[c]) v = ids[v];
+            result[c].addVertices(size, std::move(members[c]));
+            result[c].setBlackAdjacency(slices[c]);
+            slices[c] = CsrAdjacency();
+            result[c].updateBlackDegrees();
+        }
+        return result;
+    }
+
+    float getDegreeDeviation() {
+        int totalVertices = vertices.size();
+        int totalDegree = 0;
+        for(int i = 0; i < degreeToVertices.numKeys(); ++i) {
+            totalDegree += i * degreeToVertices.bucketSize(i);
+        }
+        float meanDegree = static_cast<float>(totalDegree) / totalVertices;
+
+        float sumAbsoluteDeviations = 0.0;
+        for(int i = 0; i < degreeToVertices.numKeys(); ++i) {
+            sumAbsoluteDeviations += std::abs(i - meanDegree) * degreeToVertices.bucketSize(i);
+        }
+        
+        float averageDegreeDeviation = sumAbsoluteDeviations / totalVertices;
+        return averageDegreeDeviation;
+    }
+
+    std::vector<Graph> findConnectedComponents() {
+        ankerl::unordered_dense::set<int> visited;
+        std::vector<Graph> componentGraphs;
+
+        int cnt = 0;
+        for (int vertex : vertices) {
+            if (visited.find(vertex) == visited.end()) {
+                std::vector<int> component;
+                dfs(vertex, visited, component);
+                Graph subGraph;
+                // sort(component.begin(), component.end()); // for debug, else comment
+                subGraph.addVertices(component.size(), component);
+                for (std::size_t i = 0; i < component.size(); ++i) {
+                    // subGraph.updateDegrees(i);
+                    for (int neighbor : adjListBlack[component[i]]) {
+                        if (component[i] < neighbor) {
+                            int vId = std::distance(component.begin(), std::find(component.begin(), component.end(), component[i])); 
+                            int neighborId = std::distance(component.begin(), std::find(component.begin(), component.end(), neighbor)); 
+                            subGraph.addEdgeBegin(vId, neighborId);
+                        }
+                    }
+                }
+
+                componentGraphs.push_back(subGraph);
+            }
+            // cout << cnt << endl;
+            cnt++;
+        }
+
+        return componentGraphs;
+    }
+
+    void dfs(int v, ankerl::unordered_dense::set<int>& visited, std::vector<int>& component) {
+        // std::cout << "Vertex " << v << endl;
+        // std::cout << "Count: " << cnt << endl;
+        cnt++; 
+        visited.insert(v);
+        component.push_back(v);
+        
+        // For black edges
+        for (int neighbor : adjListBlack[v]) {
+            if (std::find(visited.begin(), visited.end(), neighbor) == visited.end()) {
+                dfs(neighbor, visited, component);
+            }
+        }
+
+        // For red edges
+        for (int neighbor : adjListRed[v]) {
+            if (std::find(visited.begin(), visited.end(), neighbor) == visited.end()) {
+                dfs(neighbor, visited, component);
+            }
+        }
+    }
+
+
+    void updateVertexRedDegree(int vertex, int diff) {
+        int oldDegree = adjListRed[vertex].size();
+        record(TrailOp::RedBucket, vertex, redDegreeToVertices.key(vertex), redDegreeToVertices.before(vertex));
+        redDegreeToVertices.push(vertex, oldDegree + diff);
+    }
+
+    void updateVertexDegree(int vertex, int diff) {
+        int oldDegree = adjListRed[vertex].size() + adjListBlack[vertex].size();
+        record(TrailOp::DegreeBucket, vertex, degreeToVertices.key(vertex), degreeToVertices.before(vertex));
+        degreeToVertices.push(vertex, oldDegree + diff);
+        // trial merges are rolled back right away, their leaves do not last
+        if (oldDegree + diff == 1 && trialDepth == 0) pendants.push(vertex);
+    }
+
+    int getWorstVertex() {
+        if (redDegreeToVertices.size() == 0) return -1;
+        return redDegreeToVertices.first(redDegreeToVertices.maxKey());
+    }
+
+    bool contrainsWorstVertex(int v1, int v2, int worstVertex) {
+        const std::vector<int>& black_neighbors = adjListBlack[worstVertex];
+        const std::vector<int>& red_neighbors = adjListRed[worstVertex];
+        if (containsSorted(black_neighbors, v1)) return true;
+        if (containsSorted(red_neighbors, v1)) return true;
+        if (containsSorted(black_neighbors, v2)) return true;
+        if (containsSorted(red_neighbors, v2)) return true;
+        return false;
+    }
+
+    std::vector<int> getTopNVerticesWithLowestRedDegree(int n) {
+        return redDegreeToVertices.getTopNLowest(n);
+    }
+
+    std::vector<int> getTopNVerticesWithLowestDegree(int n) {
+        return degreeToVertices.getTopNLowest(n);
+    }
+
+    // n vertices drawn without replacement, all of them when there are fewer
+    std::vector<int> getRandomVertices(int n) {
+        std::vector<int> sample(vertices);
+        std::shuffle(sample.begin(), sample.end(), gen);
+        sample.resize(std::min<std::size_t>(sample.size(), n));
+        return sample;
+    }
+
+    void mergeVertices(int source, int twin){
+        auto start = std::chrono::steady_clock::now();
+        removeEdge(source, twin);
+        transferRedEdges(twin, source);
+        markUniqueEdgesRed(source, twin);
+        addNewRedNeighbors(source, twin);
+        removeVertex(twin);
+        touchNeighborhood(source);
+        updateWidth();
+        telemetry.count(Telemetry::MERGES);
+        telemetry.record(Telemetry::MERGE_NS, Telemetry::nanosecondsSince(start));
+    }
+
+    // The merged vertex and everything adjacent to it now are the only vertices whose
+    // neighbourhood (or edge colours) can have changed; twin's old neighbours are among them.
+    void touchNeighborhood(int source) {
+        neighborhoodVersion[source]++;
+        for (int neighbor : adjListBlack[source]) neighborhoodVersion[neighbor]++;
+        for (int neighbor : adjListRed[source]) neighborhoodVersion[neighbor]++;
+    }
+
+    // getScore through a cache that keeps entries as long as neither endpoint changed
+    int getCachedScore(ScoreCache& cache, int v1, int v2) {
+        int score;
+        if (!cache.find(v1, v2, neighborhoodVersion, score)) {
+            score = getScore(v1, v2);
+            cache.store(v1, v2, neighborhoodVersion, score);
+            telemetry.count(Telemetry::CACHE_MISSES);
+        }
+        else telemetry.count(Telemetry::CACHE_HITS);
+        return score;
+    }
+
+    // Scores every pair of candidates in the order of the serial double loop (larger vertex first),
+    // so callers reduce over the result with strict < and pick the same pair as before.
+    // Cache lookups and stores stay on this thread, only the misses are spread over scorePool;
+    // getScore only reads the graph, which makes it safe to call from several workers.
+    void scoreCandidatePairs(ScoreCache& cache, const std::vector<int>& candidates,
+                             std::vector<std::pair<int, int>>& pairs, std::vector<int>& pairScores) {
+        auto start = std::chrono::steady_clock::now();
+        pairs.clear();
+        pairScores.clear();
+        std::vector<int> misses;
+        for (std::size_t i = 0; i < candidates.size(); i++) {
+            for (std::size_t j = i+1; j < candidates.size(); j++) {
+                int v1 = candidates[i];
+                int v2 = candidates[j];
+                if (v2 > v1) {
+                    std::swap(v1, v2);
+                }
+                int score = 0;
+                if (!cache.find(v1, v2, neighborhoodVersion, score)) misses.push_back(pairs.size());
+                pairs.push_back({v1, v2});
+                pairScores.push_back(score);
+            }
+        }
+
+        if (scorePool == nullptr || misses.size() < PARALLEL_SCORE_MIN_PAIRS) {
+            for (int k : misses) pairScores[k] = getScore(pairs[k].first, pairs[k].second);
+        }
+        else {
+            scorePool->parallelFor(misses.size(), [&](std::size_t m) {
+                int k = misses[m];
+                pairScores[k] = getScore(pairs[k].first, pairs[k].second);
+            });
+        }
+        for (int k : misses) cache.store(pairs[k].first, pairs[k].second, neighborhoodVersion, pairScores[k]);
+        telemetry.count(Telemetry::CACHE_HITS, pairs.size() - misses.size());
+        telemetry.count(Telemetry::CACHE_MISSES, misses.size());
+        telemetry.record(Telemetry::CANDIDATES, pairs.size());
+        telemetry.record(Telemetry::SCORE_NS, Telemetry::nanosecondsSince(start));
+    }
+
+    void addNewRedNeighbors(int source, int twin) {
+        // Find edges of twin that are not adjacent to source
+        std::vector<int> newRedEdges;
+        std::set_difference(
+            adjListBlack[twin].begin(), adjListBlack[twin].end(),
+            adjListBlack[source].begin(), adjListBlack[source].end(),
+            std::back_inserter(newRedEdges)
+        );
+
+        // Add these edges as red edges for source
+        for (int v : newRedEdges) {
+            addEdge(source, v, "red");
+            // if (std::find(adjListRed[source].begin(), adjListRed[source].end(), v) == adjListRed[source].end()) {
+            //     addEdge(source, v, "red");
+            // }
+        }
+    }
+
+
+    void transferRedEdges(int fromVertex, int toVertex) {
+        // If the twin vertex has red edges
+        if(!adjListRed[fromVertex].empty()) {
+            for (int vertex : adjListRed[fromVertex]) {
+                if (!containsSorted(adjListRed[toVertex], vertex)) {
+                    addEdge(toVertex, vertex, "red");
+                }
+            }
+        }
+    }
+
+    void deleteTransferedEdges(int vertex, std::vector<int> neighbors) {
+        if(!neighbors.empty()) {
+            for (int neighbor : neighbors) {
+                removeEdge(vertex, neighbor);
+            }
+        }
+    }
+
+    void markUniqueEdgesRed(int source, int twin) {
+        std::vector<int> toBecomeRed;
+        std::set_difference(
+            adjListBlack[source].begin(), adjListBlack[source].end(),
+            adjListBlack[twin].begin(), adjListBlack[twin].end(),
+            std::back_inserter(toBecomeRed)
+        );
+
+        for (int v : toBecomeRed) {
+            removeEdge(source, v);
+            addEdge(source, v, "red");
+            // don't understand why is this possible since were considering only black edges
+            // if (std::find(adjListRed[source].begin(), adjListRed[source].end(), v) == adjListRed[source].end()) {
+            //     addEdge(source, v, "red");
+            // }
+        }
+    }
+
+    // Exact outcome of mergeVertices(source, twin) without touching the graph: one merge walk
+    // over both black and red lists. A neighbour x ends up red to the merged vertex unless it
+    // was black to both, and loses its red edges to source and twin, so its red degree after
+    // the merge is red(x) - [x in R(source)] - [x in R(twin)] + [x red to merged vertex].
+    // The prediction is symmetric in source and twin.
+    MergePrediction predictMerge(int source, int twin) const {
+        MergePrediction prediction;
+        const std::vector<int>& blackSource = adjListBlack[source];
+        const std::vector<int>& redSource = adjListRed[source];
+        const std::vector<int>& blackTwin = adjListBlack[twin];
+        const std::vector<int>& redTwin = adjListRed[twin];
+        std::size_t bs = 0, rs = 0, bt = 0, rt = 0;
+        while (true) {
+            int x = INT_MAX;
+            if (bs < blackSource.size()) x = std::min(x, blackSource[bs]);
+            if (rs < redSource.size()) x = std::min(x, redSource[rs]);
+            if (bt < blackTwin.size()) x = std::min(x, blackTwin[bt]);
+            if (rt < redTwin.size()) x = std::min(x, redTwin[rt]);
+            if (x == INT_MAX) break;
+
+            bool inBlackSource = bs < blackSource.size() && blackSource[bs] == x;
+            bool inRedSource = rs < redSource.size() && redSource[rs] == x;
+            bool inBlackTwin = bt < blackTwin.size() && blackTwin[bt] == x;
+            bool inRedTwin = rt < redTwin.size() && redTwin[rt] == x;
+            bs += inBlackSource;
+            rs += inRedSource;
+            bt += inBlackTwin;
+            rt += inRedTwin;
+            if (x == source || x == twin) continue;
+
+            bool red = !(inBlackSource && inBlackTwin);
+            int oldRedDegree = adjListRed[x].size();
+            int newRedDegree = oldRedDegree - inRedSource - inRedTwin + red;
+            prediction.redDegree += red;
+            prediction.maxNeighborIncrease = std::max(prediction.maxNeighborIncrease, newRedDegree - oldRedDegree);
+            prediction.maxNeighborRedDegree = std::max(prediction.maxNeighborRedDegree, newRedDegree);
+        }
+        // every other vertex keeps its red degree, which is at most the current width
+        prediction.width = std::max({width, prediction.redDegree, prediction.maxNeighborRedDegree});
+        return prediction;
+    }
+
+    // Width after merging source and twin, the merge is undone through the trail
+    int getRealScore(int source, int twin) {
+        std::size_t mark = startTrail(true);
+        mergeVertices(source, twin);
+        int mergedWidth = getWidth();
+        rollback(mark);
+        return mergedWidth;
+    }
+
+    // Opens a (possibly nested) trail: until the matching rollback or commitTrail every edge
+    // insert/delete/recolour, bucket move, vertex removal and width change is journaled.
+    // The returned mark is what rollback rewinds to. Neighbourhood versions are not rewound:
+    // rollback bumps them once more for every endpoint of an undone edge change, so ScoreCache
+    // entries stored inside the trail, scored on the graph that is undone, stop matching.
+    // A trial trail (a single merge that is scored and undone) feeds no leaves to reducePendants.
+    std::size_t startTrail(bool trial = false) {
+        openTrials.push_back(trial);
+        trialDepth += trial;
+        return trail.size();
+    }
+
+    // Undoes everything journaled since mark, the graph is exactly as it was at startTrail
+    void rollback(std::size_t mark) {
+        while (trail.size() > mark) {
+            TrailEntry entry = trail.back();
+            trail.pop_back();
+            if (entry.op == TrailOp::AddBlack || entry.op == TrailOp::AddRed || entry.op == TrailOp::RemoveBlack || entry.op == TrailOp::RemoveRed) {
+                neighborhoodVersion[entry.a]++;
+                neighborhoodVersion[entry.b]++;
+            }
+            switch (entry.op) {
+                case TrailOp::AddBlack:
+                    eraseSorted(adjListBlack[entry.a], entry.b);
+                    eraseSorted(adjListBlack[entry.b], entry.a);
+                    if (entry.c) neighborBits.removeEdge(entry.a, entry.b);
+                    break;
+                case TrailOp::AddRed:
+                    eraseSorted(adjListRed[entry.a], entry.b);
+                    eraseSorted(adjListRed[entry.b], entry.a);
+                    if (entry.c) neighborBits.removeEdge(entry.a, entry.b);
+                    break;
+                case TrailOp::RemoveBlack:
+                    insertSorted(adjListBlack[entry.a], entry.b);
+                    insertSorted(adjListBlack[entry.b], entry.a);
+                    if (entry.c) neighborBits.addEdge(entry.a, entry.b);
+                    break;
+                case TrailOp::RemoveRed:
+                    insertSorted(adjListRed[entry.a], entry.b);
+                    insertSorted(adjListRed[entry.b], entry.a);
+                    if (entry.c) neighborBits.addEdge(entry.a, entry.b);
+                    break;
+                case TrailOp::RedBucket:
+                    redDegreeToVertices.restore(entry.a, entry.b, entry.c);
+                    break;
+                case TrailOp::DegreeBucket:
+                    degreeToVertices.restore(entry.a, entry.b, entry.c);
+                    break;
+                case TrailOp::RemoveVertex:
+                    vertices.insert(vertices.begin() + entry.b, entry.a);
+                    break;
+                case TrailOp::Width:
+                    width = entry.a;
+                    break;
+            }
+        }
+        // Pendant merges done inside the trail are undone, their leaves are pending again
+        if (!closeTrail()) reseedPendants();
+    }
+
+    // Keeps the changes made since the matching startTrail
+    void commitTrail() {
+        closeTrail();
+    }
+
+    int getScore(int v1, int v2) {
+        if (v1 == v2){
+            std::cout << "hui";
+        }
+        if (bitsetScoresEnabled) return neighborBits.symmetricDifference(v1, v2);
+
+        return countMerge(neighborhood(v1), neighborhood(v2), v1, v2).symmetricDifference();
+    }
+
+    int getScoreBlack(int v1, int v2) {
+        return countMerge(SortedListsCursor(adjListBlack[v1]), SortedListsCursor(adjListBlack[v2]), v1, v2).symmetricDifference();
+    }
+
+    float getGScore(int v1, int v2) {
+        float common_neighbors_count = countMerge(neighborhood(v1), neighborhood(v2)).intersection();
+
+        // Degree Difference
+        float degree_diff = std::abs((float)(adjListBlack[v1].size() + adjListRed[v1].size()) - (float)(adjListBlack[v2].size() + adjListRed[v2].size()));
+
+        // Red Edges Count
+        float red_edges_count = adjListRed[v1].size() + adjListRed[v2].size();
+
+        // This is a simplistic formula and may need to be refined based on your specific needs and understanding of the graph structure.
+        float score = -common_neighbors_count + degree_diff + red_edges_count;
+
+        return score;
+    }
+
+    float getGScoreBlack(int v1, int v2) {
+        float common_neighbors_count = countMerge(SortedListsCursor(adjListBlack[v1]), SortedListsCursor(adjListBlack[v2])).intersection();
+
+        // Degree Difference
+        float degree_diff = std::abs((float)adjListBlack[v1].size() - (float)adjListBlack[v2].size());
+
+        // Red Edges Count
+        float red_edges_count = adjListRed[v1].size() + adjListRed[v2].size();
+
+        // This is a simplistic formula and may need to be refined based on your specific needs and understanding of the graph structure.
+        float score = -common_neighbors_count + degree_diff + red_edges_count;
+
+        return score;
+    }
+
+    float getNScore(int v1, int v2) {
+        int black_score = getScoreBlack(v1, v2);
+        int union_size = countMerge(neighborhood(v1), neighborhood(v2)).unionSize();
+        return black_score + union_size;
+    }
+
+    float getNeighborsScore(int v1, int v2) {
+        int black_score = getScoreBlack(v1, v2);
+        int union_size = countMerge(neighborhood(v1), neighborhood(v2)).unionSize();
+        return black_score +  black_score / union_size;
+    }
+
+    int getScore1(int v1, int v2) {
+        return countMerge(SortedListsCursor(adjListBlack[v1]), neighborhood(v2), v1, v2).symmetricDifference();
+    }
+
+    float getG2Score(int v1, int v2) {
+        float union_size = countMerge(neighborhood(v1), neighborhood(v2)).unionSize();
+
+        // Red-Black Edge Ratio
+        float red_edges_count = adjListRed[v1].size() + adjListRed[v2].size();
+        float black_edges_count = adjListBlack[v1].size() + adjListBlack[v2].size();
+        float red_black_ratio = (red_edges_count + 1) / (black_edges_count + 1);  // +1 to avoid division by zero
+
+        // Potential New Red Edges
+        // Assume that every neighbor of v1 and v2 will be connected by a red edge after merging
+        float potential_new_red_edges = union_size - (red_edges_count + black_edges_count);
+
+        // Score Formula: a linear combination of the above metrics
+        float score = union_size - red_black_ratio + potential_new_red_edges;
+
+        return score;
+    }
+
+    int getRandomDistance() {
+        return 1 + gen.below(2);
+    }
+
+    // Uniform over black and red neighbours by one index into the two lists, without copying
+    // them; an isolated vertex returns itself, which getRandomWalkVertices drops again
+    int getRandomNeighbor(int vertex) {
+        const std::vector<int>& black = adjListBlack[vertex];
+        const std::vector<int>& red = adjListRed[vertex];
+        if (black.empty() && red.empty()) return vertex;
+        std::uint32_t i = gen.below(black.size() + red.size());
+        return i < black.size() ? black[i] : red[i - black.size()];
+    }
+
+    std::set<int> getRandomWalkVertices(int vertex, int numberVertices) {
+        std::set<int> randomWalkVertices;
+        for (int i = 0; i < numberVertices; ++i) {
+            int distance = getRandomDistance();            
+            int randomVertex = getRandomNeighbor(vertex);
+            if (distance == 2 && adjListBlack[randomVertex].size() + adjListRed[randomVertex].size() != 0) randomVertex = getRandomNeighbor(randomVertex);
+            randomWalkVertices.insert(randomVertex);
+        }
+        randomWalkVertices.erase(vertex);
+        return randomWalkVertices;
+    }
+
+
+    // Contracts every class of false twins (trueTwins: true twins) into its first vertex.
+    // Twins have equal black neighbourhoods, so none of these merges creates a red edge;
+    // vertices that already have red edges are left out.
+    ContractionSequence findTwins(bool trueTwins) {
+        ContractionSequence contractionSequence;
+        std::vector<int> candidates;
+        for (int v : vertices) {
+            if (adjListRed[v].empty()) candidates.push_back(v);
+        }
+        std::vector<std::vector<int>> classes = TwinClasses::find(candidates,
+            [&](int v) -> const std::vector<int>& { return adjListBlack[v]; },
+            [&](int u, int v) { return containsSorted(adjListBlack[u], v); }, trueTwins);
+        for (const std::vector<int>& members : classes) {
+            for (std::size_t k = 1; k < members.size(); k++) {
+                contractionSequence.add(getVertexId(members[0]) + 1, getVertexId(members[k]) + 1);
+                mergeVertices(members[0], members[k]);
+            }
+        }
+        return contractionSequence;
+    }
+
+    // False and true twins alternately until neither finds any, see TwinClasses::reduce
+    ContractionSequence reduceTwins() {
+        ContractionSequence contractionSequence;
+        TwinClasses::reduce([&](bool trueTwins) {
+            ContractionSequence twins = findTwins(trueTwins);
+            contractionSequence.append(twins);
+            return twins.size() > 0;
+        }, [&] { return vertices.size() > 1; });
+        return contractionSequence;
+    }
+
+    // Contracts leaves with a common neighbour, see PendantQueue; the heuristics call it at
+    // the top of every iteration, so leaves created by their own merges never get scored
+    int reducePendants(ContractionSequence& contractionSequence) {
+        return reducePendants(contractionSequence, [](int, int) {});
+    }
+
+    // merged(leaf, v) is called after each merge, for heuristics that keep their own index
+    template <typename Merged>
+    int reducePendants(ContractionSequence& contractionSequence, Merged merged) {
+        if (!pendantReduction) return 0;
+        auto parentOf = [&](int v) {
+            if (adjListBlack[v].size() + adjListRed[v].size() != 1) return -1;
+            return adjListBlack[v].empty() ? adjListRed[v][0] : adjListBlack[v][0];
+        };
+        int merges = pendants.drain(parentOf, [&](int leaf, int v) {
+            contractionSequence.add(getVertexId(leaf) + 1, getVertexId(v) + 1);
+            mergeVertices(leaf, v);
+            merged(leaf, v);
+        });
+        telemetry.count(Telemetry::PENDANT_MERGES, merges);
+        return merges;
+    }
+
+
+    ContractionSequence findRedDegreeContractionRandomWalk() {
+        return RedDegreeHeuristics::randomWalk(*this);
+    }
+
+    // findRedDegreeContractionRandomWalk with extra candidates from a MinHashIndex over the whole
+    // graph: the pairs with the most similar neighbourhoods, wherever they are, are scored next
+    // to the walks. The index follows every merge, pendant ones included.
+    ContractionSequence findRedDegreeContractionMinHash(){
+        const int INDEX_PAIRS = 64;
+        ContractionSequence contractionSequence;
+        ScoreCache scores(SCORE_RESET_THRESHOLD);
+        auto forEachNeighbor = [&](int v, auto visit) {
+            for (int u : adjListBlack[v]) visit(u);
+            for (int u : adjListRed[v]) visit(u);
+        };
+        MinHashIndex index(vertices, adjListBlack.size(), forEachNeighbor);
+        auto indexMerged = [&](int survivor, int removed) { index.merged(survivor, removed, forEachNeighbor); };
+
+        while (vertices.size() > 1 && !searchAborted()) {
+            reducePendants(contractionSequence, indexMerged);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<std::pair<int, int>> candidatePairs;
+            for (const MinHashIndex::Candidate& candidate : index.topPairs(INDEX_PAIRS)) {
+                candidatePairs.push_back({std::max(candidate.u, candidate.v), std::min(candidate.u, candidate.v)});
+            }
+            for (int v1 : getTopNVerticesWithLowestRedDegree(2)) {
+                for (int v2 : getRandomWalkVertices(v1, 105)) candidatePairs.push_back({std::max(v1, v2), std::min(v1, v2)});
+            }
+
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+            auto scoreStart = std::chrono::steady_clock::now();
+            for (const auto& [v1, v2] : candidatePairs) {
+                int score = getCachedScore(scores, v1, v2);
+                if (score < bestScore) {
+                    bestScore = score;
+                    bestPair = {v1, v2};
+                }
+            }
+            telemetry.record(Telemetry::CANDIDATES, candidatePairs.size());
+            telemetry.record(Telemetry::SCORE_NS, Telemetry::nanosecondsSince(scoreStart));
+
+            contractionSequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+            mergeVertices(bestPair.first, bestPair.second);
+            indexMerged(bestPair.first, bestPair.second);
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            << std::setfill('0') << std::setw(9) << milliseconds_part 
+            << " seconds" << "\n";
+        }
+        return contractionSequence;
+    }
+
+    ComponentSolution findRedDegreeContractionRandomWalkExhaustively(const ComponentSolution& prevSolution = ComponentSolution()){ 
+        // ContractionSequence contractionSequence;
+        ComponentSolution solution;
+        ScoreCache scores(SCORE_RESET_THRESHOLD);
+        auto heuristic_start_time = std::chrono::high_resolution_clock::now();
+        
+        int iterationCounter = 0;
+        while (vertices.size() > 1 && !searchAborted()) {
+            reducePendants(solution.sequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = getTopNVerticesWithLowestRedDegree(20);
+            // vector<int> lowestDegreeVertices = getTopNVerticesWithLowestDegree(static_cast<int>(ceil(log(vertices.size())))+1);
+
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+
+            for (int i = 0; i < lowestDegreeVertices.size(); i++) {
+                int v1 = lowestDegreeVertices[i];
+                std::set<int> randomWalkVertices = getRandomWalkVertices(v1, 10);  
+              
+                for (int v2 : randomWalkVertices) {
+                    if (v2 > v1) {
+                        std::swap(v1, v2);
+                    }
+
+                    int score = getCachedScore(scores, v1, v2);
+                    
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v1, v2};
+                    }
+                }
+            }
+
+            solution.sequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+
+            mergeVertices(bestPair.first, bestPair.second);
+            solution.width = getWidth();
+
+            ContractionStep step;
+            step.iteration = iterationCounter;
+            step.vertexPair = bestPair;
+            step.score = bestScore;
+            step.width = getWidth();
+            solution.contractionSteps.push_back(step);
+
+            if (prevSolution.width != 0 && step.width > prevSolution.width) {
+                if (printProgress) std::cout << "c Discarded\n";
+                return solution;
+            }
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            << std::setfill('0') << std::setw(9) << milliseconds_part 
+            << " seconds" << "\n";
+
+            // cout << getWidth() << endl;
+            iterationCounter++;
+        }
+        // cout << "stop" << endl;
+        return solution;
+    }
+
+    ComponentSolution findDegreeContractionExhaustively(const ComponentSolution& prevSolution = ComponentSolution()){ 
+        ComponentSolution solution;
+        ContractionSequence contractionSequence;
+        ScoreCache scores(SCORE_RESET_THRESHOLD);
+        std::vector<std::pair<int, int>> candidatePairs;
+        std::vector<int> candidateScores;
+        auto heuristic_start_time = std::chrono::high_resolution_clock::now();
+        
+        int iterationCounter = 0;
+        while (vertices.size() > 1) {
+            reducePendants(solution.sequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = getTopNVerticesWithLowestDegree(20);
+            // vector<int> lowestDegreeVertices;
+            // if (vertices.size() < 50) lowestDegreeVertices = getTopNVerticesWithLowestDegree(20);
+            // else lowestDegreeVertices = getTopNVerticesWithLowestDegree(static_cast<int>(3 * ceil(log(vertices.size()))));            
+            
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+
+            scoreCandidatePairs(scores, lowestDegreeVertices, candidatePairs, candidateScores);
+            for (int k = 0; k < candidatePairs.size(); k++) {
+                if (candidateScores[k] < bestScore) {
+                    bestScore = candidateScores[k];
+                    bestPair = candidatePairs[k];
+                }
+            }
+
+            solution.sequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+
+            mergeVertices(bestPair.first, bestPair.second);
+            solution.width = getWidth();
+
+            ContractionStep step;
+            step.iteration = iterationCounter;
+            step.vertexPair = bestPair;
+            step.score = bestScore;
+            step.width = getWidth();
+            solution.contractionSteps.push_back(step);
+
+            if (prevSolution.width != 0 && step.width > prevSolution.width) {
+                if (printProgress) std::cout << "c Discarded\n";
+                return solution;
+            }
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Merged ( " << getVertexId(bestPair.first) << "," << getVertexId(bestPair.second) << "), left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            << std::setfill('0') << std::setw(9) << milliseconds_part 
+            << " seconds" << "\n";
+
+            iterationCounter++;
+        }
+        return solution;
+    }
+
+    ContractionSequence findDegreeContraction(){ 
+        ContractionSequence contractionSequence;
+        ScoreCache scores(SCORE_RESET_THRESHOLD);
+        auto heuristic_start_time = std::chrono::high_resolution_clock::now();
+        
+        int iterationCounter = 0;
+        while (vertices.size() > 1 && !searchAborted()) {
+            reducePendants(contractionSequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            // vector<int> lowestDegreeVertices = getTopNVerticesWithLowestDegree(20);
+            std::vector<int> lowestDegreeVertices = getTopNVerticesWithLowestDegree(50);
+            // vector<int> lowestDegreeVertices;
+            // if (vertices.size() < 50) lowestDegreeVertices = getTopNVerticesWithLowestDegree(20);
+            // else lowestDegreeVertices = getTopNVerticesWithLowestDegree(static_cast<int>(3 * ceil(log(vertices.size()))));            
+            
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+
+            for (int i = 0; i < lowestDegreeVertices.size(); i++) {
+                for (int j = i+1; j < lowestDegreeVertices.size(); j++) {
+                    int v1 = lowestDegreeVertices[i];
+                    int v2 = lowestDegreeVertices[j];
+                    // if (!getTwoNeighborhood(v1).contains(v2)) continue;
+                    if (v2 > v1) {
+                        std::swap(v1, v2);
+                    }
+
+                    int score = getCachedScore(scores, v1, v2);
+                    
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v1, v2};
+                    }
+                }
+            }
+
+            contractionSequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+            mergeVertices(bestPair.first, bestPair.second);
+
+
+            // if (++iterationCounter >= SCORE_RESET_THRESHOLD) {
+            //     for(int i = 0; i < scores.size(); ++i) {
+            //         scores[i].clear();
+            //     }
+            //     iterationCounter = 0;
+            // }
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Merged ( " << getVertexId(bestPair.first) << "," << getVertexId(bestPair.second) << "), left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            << std::setfill('0') << std::setw(9) << milliseconds_part 
+            << " seconds" << "\n";
+        }
+        return contractionSequence;
+    }
+
+
+    ContractionSequence findDegreeContractionRandomWalk(){ 
+        ContractionSequence contractionSequence;
+        ScoreCache scores(SCORE_RESET_THRESHOLD);
+        auto heuristic_start_time = std::chrono::high_resolution_clock::now();
+        
+        int iterationCounter = 0;
+        while (vertices.size() > 1 && !searchAborted()) {
+            reducePendants(contractionSequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = getTopNVerticesWithLowestDegree(20);
+
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+
+            for (int i = 0; i < lowestDegreeVertices.size(); i++) {
+                int v1 = lowestDegreeVertices[i];
+                std::set<int> randomWalkVertices = getRandomWalkVertices(v1, 10);  
+              
+                for (int v2 : randomWalkVertices) {
+                    if (v2 > v1) {
+                        std::swap(v1, v2);
+                    }
+
+                    int score = getCachedScore(scores, v1, v2);
+                    
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v1, v2};
+                    }
+                }
+            }
+
+            contractionSequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+
+            // if (!areInTwoNeighborhood(bestPair.first, bestPair.second)) cout << "c Not neighbors, score: " << bestScore << endl;
+            // else cout << "c Neighbors, score: " << bestScore << endl;
+
+            mergeVertices(bestPair.first, bestPair.second);
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            << std::setfill('0') << std::setw(9) << milliseconds_part 
+            << " seconds" << "\n";
+            // for(int i = 0; i < scores.size(); ++i) {
+            //     scores[i].clear();
+            // }
+        }
+        return contractionSequence;
+    }
+
+    ContractionSequence findBestVertexContraction(){ 
+        ContractionSequence contractionSequence;
+        ankerl::unordered_dense::map<std::pair<int, int>, int, PairHash> scores;
+        auto heuristic_start_time = std::chrono::high_resolution_clock::now();
+        
+        int iterationCounter = 0;
+        while (vertices.size() > 1) {
+            reducePendants(contractionSequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = getTopNVerticesWithLowestRedDegree(1);
+            int v = lowestDegreeVertices[0];
+
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+
+            for (int n1 : adjListBlack[v]) {
+                int score;
+                for (int n2 : adjListBlack[v]) {
+                    if (v == n2) continue;
+                    score = getScore(v, n2);
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v, n2};
+                    }
+                }
+                for (int n2 : adjListRed[v]) {
+                    if (v == n2) continue;
+                    score = getScore(v, n2);
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v, n2};
+                    }
+                }
+            }
+
+            for (int n1 : adjListRed[v]) {
+                int score;
+                for (int n2 : adjListBlack[v]) {
+                    if (v == n2) continue;
+                    score = getScore(v, n2);
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v, n2};
+                    }
+                }
+                for (int n2 : adjListRed[v]) {
+                    if (v == n2) continue;
+                    score = getScore(v, n2);
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v, n2};
+                    }
+                }
+            }
+
+            contractionSequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+            mergeVertices(bestPair.first, bestPair.second);
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Merged ( " << bestPair.first << "," << bestPair.second << "), left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            << std::setfill('0') << std::setw(9) << milliseconds_part 
+            << " seconds" << "\n";
+        }
+        return contractionSequence;
+    }
+
+    ContractionSequence findRedDegreeContraction() {
+        return RedDegreeHeuristics::lowestPairs(*this);
+    }
+
+    // Like findRedDegreeContraction, but the pairs of the 20 lowest red degree vertices are
+    // ranked by predictMerge: resulting width first, then the merged red degree, then getScore
+    ContractionSequence findRedDegreeContractionPredicted(){ 
+        ContractionSequence contractionSequence;
+        ScoreCache scores(SCORE_RESET_THRESHOLD);
+        std::vector<std::pair<int, int>> candidatePairs;
+        std::vector<int> candidateScores;
+        
+        while (vertices.size() > 1 && !searchAborted()) {
+            reducePendants(contractionSequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = getTopNVerticesWithLowestRedDegree(20);
+
+            std::tuple<int, int, int> bestScore = {INT_MAX, INT_MAX, INT_MAX};
+            std::pair<int, int> bestPair;
+
+            scoreCandidatePairs(scores, lowestDegreeVertices, candidatePairs, candidateScores);
+            for (int k = 0; k < candidatePairs.size(); k++) {
+                MergePrediction prediction = predictMerge(candidatePairs[k].first, candidatePairs[k].second);
+                std::tuple<int, int, int> score = {prediction.width, prediction.redDegree, candidateScores[k]};
+                if (score < bestScore) {
+                    bestScore = score;
+                    bestPair = candidatePairs[k];
+                }
+            }
+
+            contractionSequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+            mergeVertices(bestPair.first, bestPair.second);
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Merged ( " << bestPair.first << "," << bestPair.second << "), left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            << std::setfill('0') << std::setw(9) << milliseconds_part 
+            << " seconds" << "\n";
+        }
+        return contractionSequence;
+    }
+
+    ContractionSequence findRedDegreeContractionWorstVertex(){ 
+        ContractionSequence contractionSequence;
+        ScoreCache scores(SCORE_RESET_THRESHOLD);
+        std::vector<std::pair<int, int>> candidatePairs;
+        std::vector<int> candidateScores;
+        auto heuristic_start_time = std::chrono::high_resolution_clock::now();
+        
+        int iterationCounter = 0;
+        while (vertices.size() > 1 && !searchAborted()) {
+            reducePendants(contractionSequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = getTopNVerticesWithLowestRedDegree(20);
+            int worstVertex = getWorstVertex();
+            
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+
+            scoreCandidatePairs(scores, lowestDegreeVertices, candidatePairs, candidateScores);
+            for (int k = 0; k < candidatePairs.size(); k++) {
+                // the penalty depends on the current worst vertex, only the plain score is cached
+                int score = candidateScores[k];
+                if (contrainsWorstVertex(candidatePairs[k].first, candidatePairs[k].second, worstVertex)) score += 5;
+
+                if (score < bestScore) {
+                    bestScore = score;
+                    bestPair = candidatePairs[k];
+                }
+            }
+
+            contractionSequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+            mergeVertices(bestPair.first, bestPair.second);
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Merged ( " << bestPair.first << "," << bestPair.second << "), left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            << std::setfill('0') << std::setw(9) << milliseconds_part 
+            << " seconds" << "\n";
+        }
+        return contractionSequence;
+    }
+
+    ContractionSequence findRedDegreeContractionWhileLoop(){ 
+        ContractionSequence contractionSequence;
+        std::unordered_map<std::pair<int, int>, int, PairHash> scores;
+        auto heuristic_start_time = std::chrono::high_resolution_clock::now();
+        
+        std::unordered_set<int> mergedVertices;  // Moved outside the while loop
+
+        int iterationCounter = 0;
+        while (vertices.size() > 1) {
+            reducePendants(contractionSequence);
+            auto start = std::chrono::high_resolution_clock::now();
+
+            std::vector<int> lowestDegreeVertices = getTopNVerticesWithLowestRedDegree(20);
+            
+            int bestScore = INT_MAX;
+            std::pair<int, int> bestPair;
+
+            for (int i = 0; i < lowestDegreeVertices.size(); i++) {
+                for (int j = i+1; j < lowestDegreeVertices.size(); j++) {
+                    int v1 = lowestDegreeVertices[i];
+                    int v2 = lowestDegreeVertices[j];
+                    if (v2 > v1) {
+                        std::swap(v1, v2);
+                    }
+
+                    int score = getScore(v1, v2);
+                    scores[{v1, v2}] = score;
+
+                    if (score < bestScore) {
+                        bestScore = score;
+                        bestPair = {v1, v2};
+                    }
+                }
+            }
+
+            contractionSequence.add(getVertexId(bestPair.first) + 1, getVertexId(bestPair.second) + 1);
+            if (getVertexId(bestPair.second) == 85) {
+                if (printProgress) std::cout << "c checl";
+            }
+            mergeVertices(bestPair.first, bestPair.second);
+            mergedVertices.insert(bestPair.second);
+
+            for (const auto& [pair, score] : scores) {
+                auto [v1, v2] = pair;
+
+                // Check if either vertex has already been merged
+                if (mergedVertices.count(v1) || mergedVertices.count(v2)) {
+                    continue;
+                }
+
+                // // Check for independence
+                if (!checkIndependence(bestPair, pair)) {
+                    continue;
+                }
+
+                if (printProgress) std::cout << "c wow (Merged (" << getVertexId(v1) << "," << getVertexId(v2) << ")\n";
+                contractionSequence.add(getVertexId(v1) + 1, getVertexId(v2) + 1);
+                mergeVertices(v1, v2);
+                mergedVertices.insert(v2);
+            }
+
+            scores.clear();  // Clear scores for the next iteration
+
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+            int seconds_part = duration.count() / 1000;
+            int milliseconds_part = duration.count() % 1000;
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Merged ( " << getVertexId(bestPair.first) << "," << getVertexId(bestPair.second) << "), left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+                 << std::setfill('0') << std::setw(9) << milliseconds_part 
+                 << " seconds" << "\n";
+        }
+
+        return contractionSequence;
+    }
+
+    bool checkIndependence(std::pair<int, int> pair1, std::pair<int, int> pair2) {
+        // Get the second neighborhoods of the vertices in pair1 and pair2
+        std::vector<int> N2_v1 = getNeighbors(pair1.first);
+        std::vector<int> N2_v2 = getNeighbors(pair2.first);
+        std::vector<int> N2_u2 = getNeighbors(pair2.second);
+
+        std::sort(N2_v1.begin(), N2_v1.end());
+        std::sort(N2_v2.begin(), N2_v2.end());
+        std::sort(N2_u2.begin(), N2_u2.end());
+
+        // Combine the neighborhoods of each vertex pair
+        std::vector<int> union2;
+        std::set_union(N2_v2.begin(), N2_v2.end(), N2_u2.begin(), N2_u2.end(), std::back_inserter(union2));
+
+        std::sort(union2.begin(), union2.end());
+        // Check if the unions have any common elements
+        std::vector<int> intersection;
+        std::set_intersection(N2_v1.begin(), N2_v1.end(), union2.begin(), union2.end(), std::back_inserter(intersection));
+
+        return intersection.empty();  // Return true if there are no common elements, false otherwise
+    }
+
+    std::vector<int> getNeighbors(int vertex) {
+        std::vector<int> neighbors = adjListBlack[vertex];
+        neighbors.insert(neighbors.begin(), adjListRed[vertex].begin(), adjListRed[vertex].end());
+        return neighbors;
+    }
+
+    std::vector<int> getSecondNeighborhood(int vertexIndex) {
+        std::vector<bool> visited(vertices.size(), false);  // To keep track of visited vertices
+        std::queue<std::pair<int, int>> bfsQueue;  // Pair of vertex index and depth
+        
+        bfsQueue.push({vertexIndex, 0});
+        visited[vertexIndex] = true;
+        
+        std::vector<int> neighborhood;
+        
+        while (!bfsQueue.empty()) {
+            auto [currentVertex, depth] = bfsQueue.front();
+            bfsQueue.pop();
+            
+            // Explore the neighbors of the current vertex if the depth is less than 2
+            if (depth < 2) {
+                for (int neighbor : adjListBlack[currentVertex]) {  // Assuming black edges represent normal adjacency
+                    if (!visited[neighbor]) {
+                        visited[neighbor] = true;
+                        neighborhood.push_back(neighbor);
+                        bfsQueue.push({neighbor, depth + 1});
+                    }
+                }
+                
+                for (int neighbor : adjListRed[currentVertex]) {  // Assuming red edges represent normal adjacency
+                    if (!visited[neighbor]) {
+                        visited[neighbor] = true;
+                        neighborhood.push_back(neighbor);
+                        bfsQueue.push({neighbor, depth + 1});
+                    }
+                }
+            }
+        }
+
+        // Sort the neighborhood vector to enable efficient set operations later
+        std::sort(neighborhood.begin(), neighborhood.end());
+
+        return neighborhood;
+    }
+
+private:
+    // Black and red neighbours of v as one sorted sequence
+    SortedListsCursor neighborhood(int v) const {
+        return SortedListsCursor(adjListBlack[v], adjListRed[v]);
+    }
+
+    static bool containsSorted(const std::vector<int>& list, int v) {
+        return std::binary_search(list.begin(), list.end(), v);
+    }
+
+    static void insertSorted(std::vector<int>& list, int v) {
+        list.insert(std::lower_bound(list.begin(), list.end(), v), v);
+    }
+
+    static void eraseSorted(std::vector<int>& list, int v) {
+        auto it = std::lower_bound(list.begin(), list.end(), v);
+        if (it != list.end() && *it == v) list.erase(it);
+    }
+
+    // void updateWidth() {
+    //     for (const auto& innerVector : adjListRed) {
+    //         width = max(width, static_cast<int>(innerVector.size()));
+    //     }
+    // }
+
+    void updateWidth() {
+        if (redDegreeToVertices.maxKey() > width) {
+            record(TrailOp::Width, width);
+            width = redDegreeToVertices.maxKey();
+        }
+    }
+
+    void record(TrailOp op, int a, int b = 0, int c = 0) {
+        if (!openTrials.empty()) trail.push_back({op, a, b, c});
+    }
+
+    // Returns whether the closed trail was a trial
+    bool closeTrail() {
+        bool trial = openTrials.back();
+        openTrials.pop_back();
+        trialDepth -= trial;
+        if (openTrials.empty()) trail.clear();
+        return trial;
+    }
+
+    void reseedPendants() {
+        if (degreeToVertices.numKeys() <= 1) return;
+        for (int v = degreeToVertices.first(1); v != BucketQueue::NONE; v = degreeToVertices.after(v)) pendants.push(v);
+    }
+
+    int getUpdatedWidth() {
+        int updatedWidth = 0;
+        for (const auto& innerVector : adjListRed) {
+            updatedWidth = std::max(updatedWidth, static_cast<int>(innerVector.size()));
+        }
+        return updatedWidth;
+    }
+};
+
+#endif // VECTORGRAPH_HPP
@@ -0,0 +1,166 @@
+#ifndef VERIFIER_HPP
+#define VERIFIER_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "GrReader.hpp"
+#include "VectorGraph.hpp"
+
+// One line of solver output as Verifier reads it: blank
+// lines and "c" comments are skipped, anything else has to be exactly two vertex ids.
+// Ids saturate just above n, so illegal() reports them as out of range.
+struct ContractionLine {
+    enum Kind { SKIPPED, PAIR, MALFORMED };
+    Kind kind = SKIPPED;
+    long long survivor = 0;
+    long long merged = 0;
+
+    static ContractionLine parse(const char* begin, const char* end, long long n) {
+        ContractionLine line;
+        while (begin < end && isBlank(*begin)) ++begin;
+        while (end > begin && (isBlank(end[-1]) || end[-1] == '\n')) --end;
+        if (begin == end || *begin == 'c') return line;
+        line.kind = MALFORMED;
+        long long ids[2];
+        for (long long& id : ids) {
+            while (begin < end && isBlank(*begin)) ++begin;
+            if (begin == end || *begin < '0' || *begin > '9') return line;
+            id = 0;
+            while (begin < end && *begin >= '0' && *begin <= '9') id = std::min(id * 10 + (*begin++ - '0'), n + 1);
+        }
+        while (begin < end && isBlank(*begin)) ++begin;
+        if (begin != end) return line;
+        line.kind = PAIR;
+        line.survivor = ids[0];
+        line.merged = ids[1];
+        return line;
+    }
+
+    // Why the pair can not be contracted while alive holds the remaining vertices, empty if it can
+    std::string illegal(const std::vector<bool>& alive) const {
+        long long n = alive.size();
+        if (survivor < 1 || survivor > n || merged < 1 || merged > n) {
+            return "pair " + std::to_string(survivor) + " " + std::to_string(merged) + " names a vertex outside 1.." + std::to_string(n);
+        }
+        if (survivor == merged) return "vertex " + std::to_string(survivor) + " can not be contracted with itself";
+        if (!alive[survivor - 1]) return "vertex " + std::to_string(survivor) + " is not part of the graph anymore";
+        if (!alive[merged - 1]) return "vertex " + std::to_string(merged) + " is not part of the graph anymore";
+        return "";
+    }
+
+    static bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+};
+
+// In-process replacement for scripts/verifier.py, shared by verifier.cpp and batch-runner:
+// replays a contraction sequence with the solver's own Graph merge (sorted adjacency lists,
+// red degrees in BucketQueue, width kept by updateWidth) and tracks the largest red degree
+// seen after any step. Vertices are the 1-based ids the solvers print. Malformed or illegal
+// pairs are skipped and counted, the sequence then counts as invalid; error() keeps the
+// first of them and messages() the first MAX_MESSAGES.
+class Verifier {
+public:
+    static constexpr std::size_t MAX_MESSAGES = 20;
+
+    explicit Verifier(const GrInstance& instance) : alive(instance.numVertices, true), numAlive(instance.numVertices) {
+        // Only mergeVertices is used, no enableBitsetScores: the dense matrix would be wasted memory
+        g.addVertices(instance.numVertices);
+        g.setBlackAdjacency(CsrAdjacency::fromEdges(instance.numVertices, instance.edges));
+        g.updateBlackDegrees();
+        g.setPrintProgress(false);
+    }
+
+    // One line of solver output, see ContractionLine; false if it was skipped as malformed
+    bool addLine(const char* begin, const char* end) {
+        lineNumber++;
+        ContractionLine line = ContractionLine::parse(begin, end, alive.size());
+        if (line.kind == ContractionLine::SKIPPED) return true;
+        if (line.kind == ContractionLine::MALFORMED) return malformed(begin, end, "expected two vertex ids");
+        std::string reason = line.illegal(alive);
+        if (!reason.empty()) return malformed(begin, end, reason);
+
+        g.mergeVertices(line.survivor - 1, line.merged - 1);
+        alive[line.merged - 1] = false;
+        numAlive--;
+        steps_++;
+        if (g.getWidth() > width_) {
+            width_ = g.getWidth();
+            widthStep_ = steps_;
+            widthLine_ = lineNumber;
+        }
+        return true;
+    }
+
+    // Feeds a whole output buffer line by line
+    bool addOutput(const char* begin, const char* end) {
+        while (begin < end) {
+            const char* lineEnd = std::find(begin, end, '\n');
+            addLine(begin, lineEnd);
+            begin = lineEnd < end ? lineEnd + 1 : end;
+        }
+        return error_.empty();
+    }
+
+    // A valid sequence has no malformed pairs and leaves at most one vertex
+    bool complete() const {
+        return error_.empty() && numAlive <= 1;
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    // Step (1-based) after which width() was first reached, 0 if it never exceeded 0
+    long long widthStep() const {
+        return widthStep_;
+    }
+
+    // Line of that step
+    long long widthLine() const {
+        return widthLine_;
+    }
+
+    long long steps() const {
+        return steps_;
+    }
+
+    int remaining() const {
+        return numAlive;
+    }
+
+    long long errors() const {
+        return errors_;
+    }
+
+    const std::string& error() const {
+        return error_;
+    }
+
+    const std::vector<std::string>& messages() const {
+        return messages_;
+    }
+
+private:
+    Graph g;
+    std::vector<bool> alive; // Graph only keeps a list of its vertices, too slow to search per step
+    int numAlive;
+    int width_ = 0;
+    long long steps_ = 0;
+    long long widthStep_ = 0;
+    long long widthLine_ = 0;
+    long long lineNumber = 0;
+    long long errors_ = 0;
+    std::string error_;
+    std::vector<std::string> messages_;
+
+    bool malformed(const char* begin, const char* end, const std::string& reason) {
+        std::string message = "line " + std::to_string(lineNumber) + " \"" + std::string(begin, end) + "\": " + reason;
+        if (errors_++ == 0) error_ = message;
+        if (messages_.size() < MAX_MESSAGES) messages_.push_back(std::move(message));
+        return false;
+    }
+};
+
+#endif // VERIFIER_HPP
@@ -0,0 +1,82 @@
+#ifndef WORKSTEALINGSCHEDULER_HPP
+#define WORKSTEALINGSCHEDULER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs a fixed batch of independent tasks (one per connected component) on a
+// set of threads. Tasks are dealt round robin in the given order, every worker
+// takes its own tasks from the front and, once it runs dry, steals from the back
+// of the other queues. With the order sorted by size the giant component starts
+// first and the small ones fill the remaining threads. Build with -pthread.
+class WorkStealingScheduler {
+public:
+    explicit WorkStealingScheduler(int numThreads) : numThreads(std::max(1, numThreads)) {}
+
+    // Calls task(i) once for every i in order; returns when all of them finished
+    void run(const std::vector<int>& order, const std::function<void(int)>& task) {
+        int numWorkers = std::min<int>(numThreads, order.size());
+        if (numWorkers <= 1) {
+            for (int i : order) task(i);
+            return;
+        }
+
+        queues.clear();
+        for (int w = 0; w < numWorkers; ++w) queues.push_back(std::make_unique<WorkerQueue>());
+        for (std::size_t k = 0; k < order.size(); ++k) queues[k % numWorkers]->tasks.push_back(order[k]);
+
+        std::vector<std::thread> threads;
+        for (int w = 1; w < numWorkers; ++w) {
+            threads.emplace_back([this, w, &task] { workerLoop(w, task); });
+        }
+        workerLoop(0, task);
+        for (std::thread& t : threads) t.join();
+        queues.clear();
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    int numThreads;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+    bool popOwn(int worker, int& task) {
+        WorkerQueue& queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    bool steal(int worker, int& task) {
+        for (std::size_t k = 1; k < queues.size(); ++k) {
+            WorkerQueue& victim = *queues[(worker + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.tasks.empty()) continue;
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+        return false;
+    }
+
+    // No task spawns new ones, so all queues being empty means the batch is done
+    void workerLoop(int worker, const std::function<void(int)>& task) {
+        int next;
+        while (popOwn(worker, next) || steal(worker, next)) {
+            task(next);
+        }
+    }
+};
+
+#endif // WORKSTEALINGSCHEDULER_HPP
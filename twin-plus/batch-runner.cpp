@@ -0,0 +1,337 @@
+// Runs a solver binary over a set of .gr instances, replacing scripts/run_tests.sh for
+// the C++ solvers. Instances run in parallel, each as its own process with the instance
+// on stdin and a hard time limit (SIGTERM, then SIGKILL after a grace period). The
+// sequence is checked in-process by Verifier, wall time and peak RSS come from wait4.
+// One CSV row per instance; with --baseline the rows are compared to an earlier CSV and
+// larger widths, failures and slowdowns beyond --tolerance are reported (exit code 1).
+//
+// Usage: batch-runner [--solver PATH] [--jobs J] [--time-limit S] [--output FILE]
+//                     [--baseline FILE] [--tolerance F] (instance.gr | directory) ...
+// Build: g++ -std=c++20 -O2 -pthread batch-runner.cpp -o batch-runner
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "GrReader.hpp"
+#include "ThreadPool.hpp"
+#include "Verifier.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+const auto KILL_GRACE = seconds(2); // between SIGTERM and SIGKILL
+const auto POLL_INTERVAL = milliseconds(2);
+const double MIN_SLOWDOWN_SECONDS = 0.1; // shorter differences are noise, whatever the ratio
+
+string solverPath = "./solver-vectors";
+int jobs = max(1, (int)thread::hardware_concurrency() / 2); // the solvers start worker threads of their own
+double timeLimit = 60;
+string outputPath = "batch-results.csv";
+string baselinePath;
+double tolerance = 1.2; // wall time ratio above which a run counts as slower
+
+struct RunResult {
+    string instance;
+    int vertices = 0;
+    long long edges = 0;
+    string status; // ok, timeout, crashed, invalid, mismatch (a reported width that is not the verified one)
+    int width = -1; // verified, -1 unless the sequence is valid
+    int reportedWidth = -1; // from the "c twin-width:" line, -1 if the solver prints none
+    double wallSeconds = 0;
+    long peakRssKb = 0;
+    long long steps = 0;
+    string error;
+
+    double stepsPerSecond() const {
+        return wallSeconds > 0 ? steps / wallSeconds : 0;
+    }
+};
+
+vector<string> collectInstances(const vector<string>& arguments) {
+    vector<string> instances;
+    for (const string& argument : arguments) {
+        if (!filesystem::is_directory(argument)) {
+            instances.push_back(argument);
+            continue;
+        }
+        vector<string> found;
+        for (const auto& entry : filesystem::recursive_directory_iterator(argument)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".gr") found.push_back(entry.path().string());
+        }
+        sort(found.begin(), found.end());
+        instances.insert(instances.end(), found.begin(), found.end());
+    }
+    return instances;
+}
+
+string readFile(int fd) {
+    string content;
+    char buffer[1 << 16];
+    ssize_t got;
+    while ((got = ::read(fd, buffer, sizeof(buffer))) > 0) content.append(buffer, got);
+    return content;
+}
+
+int parseReportedWidth(const string& output) {
+    const string PREFIX = "c twin-width: ";
+    size_t at = output.find(PREFIX);
+    if (at == string::npos) return -1;
+    return atoi(output.c_str() + at + PREFIX.size());
+}
+
+RunResult runInstance(const string& instance) {
+    RunResult result;
+    result.instance = instance;
+
+    // Read before the solver runs: GrReader throws on a malformed file, and an exception
+    // escaping this ThreadPool worker would end the whole batch without a CSV
+    GrInstance graph;
+    try {
+        graph = GrReader::read(instance.c_str());
+    } catch (const exception& e) {
+        result.status = "invalid";
+        result.error = e.what();
+        return result;
+    }
+    result.vertices = graph.numVertices;
+    result.edges = graph.edges.size();
+
+    char outputName[] = "/tmp/batch-runner-XXXXXX";
+    // Close-on-exec, children forked by the other jobs must not inherit them
+    int outputFd = mkostemp(outputName, O_CLOEXEC);
+    int inputFd = ::open(instance.c_str(), O_RDONLY | O_CLOEXEC);
+    if (outputFd >= 0) ::unlink(outputName); // the descriptor keeps the file alive
+    if (outputFd < 0 || inputFd < 0) {
+        result.status = "crashed";
+        result.error = outputFd < 0 ? "cannot create output file" : "cannot open instance";
+        if (outputFd >= 0) ::close(outputFd);
+        if (inputFd >= 0) ::close(inputFd);
+        return result;
+    }
+
+    // Everything the child needs is prepared before fork, the child only calls async-signal-safe functions
+    char* const argv[] = {const_cast<char*>(solverPath.c_str()), nullptr};
+    auto start = steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        int devNull = ::open("/dev/null", O_WRONLY);
+        dup2(inputFd, 0);
+        dup2(outputFd, 1);
+        if (devNull >= 0) dup2(devNull, 2);
+        execv(solverPath.c_str(), argv);
+        _exit(127);
+    }
+    ::close(inputFd);
+
+    int status = 0;
+    struct rusage usage = {};
+    bool timedOut = false;
+    bool terminated = false;
+    auto limit = start + duration_cast<steady_clock::duration>(duration<double>(timeLimit));
+    while (pid > 0 && wait4(pid, &status, WNOHANG, &usage) == 0) {
+        auto now = steady_clock::now();
+        if (now >= limit + KILL_GRACE) {
+            kill(pid, SIGKILL);
+        } else if (now >= limit && !terminated) {
+            kill(pid, SIGTERM);
+            timedOut = terminated = true;
+        }
+        this_thread::sleep_for(POLL_INTERVAL);
+    }
+    result.wallSeconds = duration<double>(steady_clock::now() - start).count();
+    result.peakRssKb = usage.ru_maxrss;
+
+    lseek(outputFd, 0, SEEK_SET);
+    string output = readFile(outputFd);
+    ::close(outputFd);
+    result.reportedWidth = parseReportedWidth(output);
+
+    if (pid < 0) {
+        result.status = "crashed";
+        result.error = "fork failed";
+        return result;
+    }
+    if (timedOut) {
+        result.status = "timeout";
+        return result;
+    }
+    if (WIFSIGNALED(status) || WEXITSTATUS(status) != 0) {
+        result.status = "crashed";
+        result.error = WIFSIGNALED(status) ? string("signal ") + strsignal(WTERMSIG(status))
+                                           : "exit code " + to_string(WEXITSTATUS(status));
+        return result;
+    }
+
+    Verifier verifier(graph);
+    verifier.addOutput(output.data(), output.data() + output.size());
+    result.steps = verifier.steps();
+    if (!verifier.error().empty() || !verifier.complete()) {
+        result.status = "invalid";
+        result.error = !verifier.error().empty() ? verifier.error()
+                                                 : to_string(verifier.remaining()) + " vertices left uncontracted";
+        return result;
+    }
+    result.width = verifier.width();
+    // Solvers that print no width (solver.cpp) are only checked by the verifier
+    bool reported = result.reportedWidth >= 0;
+    result.status = !reported || result.reportedWidth == result.width ? "ok" : "mismatch";
+    if (result.status == "mismatch") result.error = "solver reported " + to_string(result.reportedWidth);
+    return result;
+}
+
+string quoteCsv(const string& field) {
+    if (field.find_first_of(",\"\n") == string::npos) return field;
+    string quoted = "\"";
+    for (char c : field) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+vector<string> splitCsvLine(const string& line) {
+    vector<string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (quoted && c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+            fields.back() += '"';
+            i++;
+        } else if (c == '"') {
+            quoted = !quoted;
+        } else if (c == ',' && !quoted) {
+            fields.emplace_back();
+        } else {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+const char* CSV_HEADER = "instance,vertices,edges,status,width,reported_width,wall_s,peak_rss_kb,steps,steps_per_s,error";
+
+void writeCsv(const string& path, const vector<RunResult>& results) {
+    ofstream out(path);
+    out << CSV_HEADER << "\n";
+    for (const RunResult& r : results) {
+        out << quoteCsv(r.instance) << "," << r.vertices << "," << r.edges << "," << r.status << "," << r.width << ","
+            << (r.reportedWidth >= 0 ? to_string(r.reportedWidth) : "") << "," << fixed << setprecision(3) << r.wallSeconds << "," << r.peakRssKb << ","
+            << r.steps << "," << setprecision(1) << r.stepsPerSecond() << "," << quoteCsv(r.error) << "\n";
+    }
+}
+
+// Rows of an earlier run by instance, only the columns the comparison needs
+map<string, RunResult> readBaseline(const string& path) {
+    map<string, RunResult> baseline;
+    ifstream in(path);
+    string line;
+    if (!getline(in, line)) throw runtime_error("Cannot read baseline " + path);
+    vector<string> header = splitCsvLine(line);
+    auto column = [&](const string& name) {
+        auto it = find(header.begin(), header.end(), name);
+        if (it == header.end()) throw runtime_error("Baseline " + path + " has no column " + name);
+        return it - header.begin();
+    };
+    size_t instanceColumn = column("instance"), statusColumn = column("status");
+    size_t widthColumn = column("width"), wallColumn = column("wall_s");
+    while (getline(in, line)) {
+        vector<string> fields = splitCsvLine(line);
+        if (fields.size() < header.size()) continue;
+        RunResult r;
+        r.instance = fields[instanceColumn];
+        r.status = fields[statusColumn];
+        r.width = atoi(fields[widthColumn].c_str());
+        r.wallSeconds = atof(fields[wallColumn].c_str());
+        baseline[r.instance] = r;
+    }
+    return baseline;
+}
+
+// Prints one line per changed instance, returns the number of regressions
+int compareToBaseline(const vector<RunResult>& results, const map<string, RunResult>& baseline) {
+    int regressions = 0, improvements = 0, compared = 0;
+    for (const RunResult& r : results) {
+        auto it = baseline.find(r.instance);
+        if (it == baseline.end()) continue;
+        const RunResult& b = it->second;
+        compared++;
+        if (b.status == "ok" && r.status != "ok") {
+            cout << "REGRESSION " << r.instance << ": " << r.status << ", baseline was ok\n";
+            regressions++;
+        } else if (b.status == "ok" && r.width > b.width) {
+            cout << "REGRESSION " << r.instance << ": width " << r.width << ", baseline " << b.width << "\n";
+            regressions++;
+        } else if (b.status == "ok" && r.wallSeconds > b.wallSeconds * tolerance && r.wallSeconds - b.wallSeconds > MIN_SLOWDOWN_SECONDS) {
+            cout << "REGRESSION " << r.instance << ": " << fixed << setprecision(3) << r.wallSeconds << " s, baseline "
+                 << b.wallSeconds << " s\n";
+            regressions++;
+        } else if (r.status == "ok" && (b.status != "ok" || r.width < b.width)) {
+            cout << "improved " << r.instance << ": width " << r.width << ", baseline "
+                 << (b.status == "ok" ? to_string(b.width) : b.status) << "\n";
+            improvements++;
+        }
+    }
+    cout << "c compared " << compared << " instances with " << baselinePath << ": " << regressions << " regressions, "
+         << improvements << " improvements\n";
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> arguments;
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (option == "--solver" && hasValue) solverPath = argv[++i];
+        else if (option == "--jobs" && hasValue) jobs = max(1, atoi(argv[++i]));
+        else if (option == "--time-limit" && hasValue) timeLimit = atof(argv[++i]);
+        else if (option == "--output" && hasValue) outputPath = argv[++i];
+        else if (option == "--baseline" && hasValue) baselinePath = argv[++i];
+        else if (option == "--tolerance" && hasValue) tolerance = atof(argv[++i]);
+        else arguments.push_back(option);
+    }
+    vector<string> instances = collectInstances(arguments);
+    if (instances.empty()) {
+        cerr << "Usage: batch-runner [--solver PATH] [--jobs J] [--time-limit S] [--output FILE] "
+                "[--baseline FILE] [--tolerance F] (instance.gr | directory) ..." << endl;
+        return 2;
+    }
+    map<string, RunResult> baseline;
+    if (!baselinePath.empty()) baseline = readBaseline(baselinePath); // before the runs, a bad path fails fast
+
+    cout << left << setw(40) << "instance" << setw(10) << "status" << setw(8) << "width" << setw(10) << "time"
+         << setw(12) << "rss" << "steps/s" << "\n";
+    vector<RunResult> results(instances.size());
+    mutex printMutex;
+    ThreadPool pool(jobs);
+    pool.parallelFor(instances.size(), [&](size_t i) {
+        results[i] = runInstance(instances[i]);
+        const RunResult& r = results[i];
+        lock_guard<mutex> lock(printMutex);
+        cout << left << setw(40) << r.instance << setw(10) << r.status << setw(8) << r.width << fixed
+             << setprecision(2) << setw(10) << r.wallSeconds << setw(12) << r.peakRssKb << setprecision(0)
+             << r.stepsPerSecond() << (r.error.empty() ? "" : "  " + r.error) << endl;
+    });
+
+    writeCsv(outputPath, results);
+    int failed = count_if(results.begin(), results.end(), [](const RunResult& r) { return r.status != "ok"; });
+    cout << "c " << results.size() << " instances, " << failed << " not ok, results in " << outputPath << "\n";
+    if (!baselinePath.empty() && compareToBaseline(results, baseline) > 0) return 1;
+    return 0;
+}
@@ -0,0 +1,296 @@
+// Microbenchmarks for the Graph primitives on the hot path of solver-vectors: mergeVertices,
+// the score variants, getTopNVerticesWithLowestRedDegree, splitComponents and
+// reduceTwins. Every primitive is timed in isolation on a prepared graph, one warm-up run is
+// dropped and the remaining runs are reported as ns per operation (mean, stddev, min, median).
+// Graphs, merge plans and scored pairs only depend on --seed, so runs are reproducible.
+//
+// Usage: benchmark [--reps N] [--seed S] [instance.gr ...]
+//   without instances the built-in sparse, dense, power-law and grid generators are used.
+// Build: g++ -std=c++20 -O2 -pthread benchmark.cpp -o benchmark
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include "VectorGraph.hpp"
+#include "GrReader.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+struct BenchmarkInstance {
+    string name;
+    int numVertices;
+    vector<pair<int, int>> edges;
+};
+
+int reps = 7;
+uint64_t seed = 1;
+volatile double sink; // keeps the measured calls from being optimised away
+
+// Only the raw generator output is used, std distributions differ between standard libraries
+uint64_t randomBelow(mt19937_64& rng, uint64_t bound) {
+    return rng() % bound;
+}
+
+double randomUnit(mt19937_64& rng) {
+    return (rng() >> 11) * 0x1.0p-53;
+}
+
+BenchmarkInstance generateSparse(int n, int m) {
+    mt19937_64 rng(seed);
+    BenchmarkInstance instance{"sparse", n, {}};
+    for (int i = 0; i < m; i++) instance.edges.push_back({(int)randomBelow(rng, n), (int)randomBelow(rng, n)});
+    return instance;
+}
+
+BenchmarkInstance generateDense(int n, double p) {
+    mt19937_64 rng(seed + 1);
+    BenchmarkInstance instance{"dense", n, {}};
+    for (int u = 0; u < n; u++) {
+        for (int v = u + 1; v < n; v++) {
+            if (randomUnit(rng) < p) instance.edges.push_back({u, v});
+        }
+    }
+    return instance;
+}
+
+// Chung-Lu: endpoints drawn proportionally to weights (i + 1)^(-1 / (exponent - 1))
+BenchmarkInstance generatePowerLaw(int n, int m, double exponent) {
+    mt19937_64 rng(seed + 2);
+    BenchmarkInstance instance{"power-law", n, {}};
+    vector<double> cumulative(n);
+    double total = 0;
+    for (int i = 0; i < n; i++) {
+        total += pow(i + 1.0, -1.0 / (exponent - 1.0));
+        cumulative[i] = total;
+    }
+    auto draw = [&]() {
+        return (int)(lower_bound(cumulative.begin(), cumulative.end(), randomUnit(rng) * total) - cumulative.begin());
+    };
+    for (int i = 0; i < m; i++) instance.edges.push_back({draw(), draw()});
+    return instance;
+}
+
+BenchmarkInstance generateGrid(int rows, int cols) {
+    BenchmarkInstance instance{"grid", rows * cols, {}};
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (c + 1 < cols) instance.edges.push_back({r * cols + c, r * cols + c + 1});
+            if (r + 1 < rows) instance.edges.push_back({r * cols + c, (r + 1) * cols + c});
+        }
+    }
+    return instance;
+}
+
+BenchmarkInstance readInstance(const char* path) {
+    GrInstance input = GrReader::read(path);
+    const char* name = strrchr(path, '/');
+    return {name != nullptr ? name + 1 : path, input.numVertices, std::move(input.edges)};
+}
+
+Graph buildGraph(const BenchmarkInstance& instance, bool bitsetScores) {
+    Graph g;
+    g.addVertices(instance.numVertices);
+    g.setBlackAdjacency(CsrAdjacency::fromEdges(instance.numVertices, instance.edges));
+    g.updateBlackDegrees();
+    if (bitsetScores) g.enableBitsetScores();
+    g.setIds(g.getVertices());
+    g.setPrintProgress(false);
+    return g;
+}
+
+// Merges a random live vertex into a random neighbour (any live vertex if it has none),
+// recorded once so every run replays the same sequence
+vector<pair<int, int>> planMerges(const Graph& base, int count) {
+    mt19937_64 rng(seed + 3);
+    Graph g(base);
+    g.setPrintProgress(false);
+    vector<pair<int, int>> plan;
+    for (int k = 0; k < count; k++) {
+        vector<int> live = g.getVertices();
+        if (live.size() < 2) break;
+        int v = live[randomBelow(rng, live.size())];
+        vector<int> neighbors = g.getNeighbors(v);
+        int u = v;
+        if (!neighbors.empty()) u = neighbors[randomBelow(rng, neighbors.size())];
+        while (u == v) u = live[randomBelow(rng, live.size())];
+        g.mergeVertices(v, u);
+        plan.push_back({v, u});
+    }
+    return plan;
+}
+
+// Half of the pairs are two hops apart, the kind the heuristics score, half are arbitrary.
+// Isolated vertices are left out, the solver only scores within connected components
+// and getNeighborsScore divides by the size of the joint neighbourhood.
+vector<pair<int, int>> planPairs(Graph& g, std::size_t count) {
+    mt19937_64 rng(seed + 4);
+    vector<int> live;
+    for (int v : g.getVertices()) {
+        if (!g.getNeighbors(v).empty()) live.push_back(v);
+    }
+    vector<pair<int, int>> pairs;
+    while (pairs.size() < count && live.size() > 1) {
+        int v = live[randomBelow(rng, live.size())];
+        int u = live[randomBelow(rng, live.size())];
+        if (pairs.size() % 2 == 0) {
+            vector<int> neighbors = g.getNeighbors(v);
+            vector<int> secondNeighbors = g.getNeighbors(neighbors[randomBelow(rng, neighbors.size())]);
+            // the walk may only lead back to v (a matching edge), keep the uniform partner then
+            int w = secondNeighbors[randomBelow(rng, secondNeighbors.size())];
+            if (w != v) u = w;
+        }
+        if (u != v) pairs.push_back({max(u, v), min(u, v)});
+    }
+    return pairs;
+}
+
+struct Stats {
+    double mean = 0;
+    double stddev = 0;
+    double min = 0;
+    double median = 0;
+};
+
+Stats summarize(vector<double> samples) {
+    Stats stats;
+    sort(samples.begin(), samples.end());
+    for (double s : samples) stats.mean += s;
+    stats.mean /= samples.size();
+    for (double s : samples) stats.stddev += (s - stats.mean) * (s - stats.mean);
+    stats.stddev = samples.size() > 1 ? sqrt(stats.stddev / (samples.size() - 1)) : 0;
+    stats.min = samples.front();
+    size_t middle = samples.size() / 2;
+    stats.median = samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+    return stats;
+}
+
+// run() performs ops operations and returns the nanoseconds they took
+void report(const string& graphName, const string& primitive, long long ops, const function<double()>& run) {
+    if (ops == 0) return;
+    run(); // warm-up
+    vector<double> samples;
+    for (int r = 0; r < reps; r++) samples.push_back(run() / ops);
+    Stats stats = summarize(samples);
+    cout << left << setw(12) << graphName << setw(26) << primitive << right << setw(9) << ops
+         << fixed << setprecision(1) << setw(14) << stats.mean << setw(12) << stats.stddev
+         << setw(14) << stats.min << setw(14) << stats.median << "\n";
+}
+
+template <typename Score>
+void reportScore(const string& graphName, const string& primitive, Graph& g, const vector<pair<int, int>>& pairs, Score score) {
+    report(graphName, primitive, pairs.size(), [&]() {
+        auto start = steady_clock::now();
+        double total = 0;
+        for (const auto& [v1, v2] : pairs) total += score(g, v1, v2);
+        double elapsed = Telemetry::nanosecondsSince(start);
+        sink = total;
+        return elapsed;
+    });
+}
+
+void benchmarkInstance(const BenchmarkInstance& instance) {
+    Graph base = buildGraph(instance, true);
+    Graph baseLists = buildGraph(instance, false);
+    long long numEdges = 0;
+    for (int v : base.getVertices()) numEdges += base.getNeighbors(v).size();
+    cout << "c " << instance.name << ": n = " << instance.numVertices << ", m = " << numEdges / 2 << "\n";
+
+    // Merges replay the plan on a fresh copy per run, the copy is not timed
+    vector<pair<int, int>> plan = planMerges(base, min(2000, instance.numVertices / 4));
+    report(instance.name, "mergeVertices", plan.size(), [&]() {
+        Graph g(base);
+        auto start = steady_clock::now();
+        for (const auto& [v, u] : plan) g.mergeVertices(v, u);
+        double elapsed = Telemetry::nanosecondsSince(start);
+        sink = g.getWidth();
+        return elapsed;
+    });
+
+    // Scores and bucket queries run on the graph halfway through the plan, where red edges exist
+    Graph contracted(base);
+    Graph contractedLists(baseLists);
+    for (std::size_t k = 0; k < plan.size() / 2; k++) {
+        contracted.mergeVertices(plan[k].first, plan[k].second);
+        contractedLists.mergeVertices(plan[k].first, plan[k].second);
+    }
+    vector<pair<int, int>> pairs = planPairs(contracted, 20000);
+    reportScore(instance.name, "getScore", contracted, pairs, [](Graph& g, int a, int b) { return g.getScore(a, b); });
+    // Components too large for the bitsets score on the lists anyway
+    if (BitsetAdjacency::fits(instance.numVertices)) {
+        reportScore(instance.name, "getScore (lists)", contractedLists, pairs, [](Graph& g, int a, int b) { return g.getScore(a, b); });
+    }
+    reportScore(instance.name, "getScoreBlack", contracted, pairs, [](Graph& g, int a, int b) { return g.getScoreBlack(a, b); });
+    reportScore(instance.name, "getScore1", contracted, pairs, [](Graph& g, int a, int b) { return g.getScore1(a, b); });
+    reportScore(instance.name, "getGScore", contracted, pairs, [](Graph& g, int a, int b) { return g.getGScore(a, b); });
+    reportScore(instance.name, "getGScoreBlack", contracted, pairs, [](Graph& g, int a, int b) { return g.getGScoreBlack(a, b); });
+    reportScore(instance.name, "getG2Score", contracted, pairs, [](Graph& g, int a, int b) { return g.getG2Score(a, b); });
+    reportScore(instance.name, "getNScore", contracted, pairs, [](Graph& g, int a, int b) { return g.getNScore(a, b); });
+    reportScore(instance.name, "getNeighborsScore", contracted, pairs, [](Graph& g, int a, int b) { return g.getNeighborsScore(a, b); });
+    reportScore(instance.name, "predictMerge", contracted, pairs, [](Graph& g, int a, int b) { return g.predictMerge(a, b).width; });
+
+    const int TOP_N_CALLS = 10000;
+    report(instance.name, "getTopNLowestRedDegree", TOP_N_CALLS, [&]() {
+        auto start = steady_clock::now();
+        size_t total = 0;
+        for (int k = 0; k < TOP_N_CALLS; k++) total += contracted.getTopNVerticesWithLowestRedDegree(20).size();
+        double elapsed = Telemetry::nanosecondsSince(start);
+        sink = total;
+        return elapsed;
+    });
+
+    // One candidate set of findRedDegreeContraction per start vertex, walks of length 1 or 2
+    report(instance.name, "getRandomWalkVertices", pairs.size(), [&]() {
+        auto start = steady_clock::now();
+        size_t total = 0;
+        for (const auto& pair : pairs) total += contracted.getRandomWalkVertices(pair.first, 105).size();
+        double elapsed = Telemetry::nanosecondsSince(start);
+        sink = total;
+        return elapsed;
+    });
+
+    report(instance.name, "splitComponents", 1, [&]() {
+        Graph g(base);
+        auto start = steady_clock::now();
+        vector<Graph> components = std::move(g).splitComponents();
+        double elapsed = Telemetry::nanosecondsSince(start);
+        sink = components.size();
+        return elapsed;
+    });
+
+    report(instance.name, "reduceTwins", 1, [&]() {
+        Graph g(base);
+        g.setPrintProgress(false);
+        auto start = steady_clock::now();
+        ContractionSequence twins = g.reduceTwins();
+        double elapsed = Telemetry::nanosecondsSince(start);
+        sink = twins.size();
+        return elapsed;
+    });
+}
+
+int main(int argc, char* argv[]) {
+    vector<const char*> paths;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) reps = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else paths.push_back(argv[i]);
+    }
+    // The primitives are measured single threaded, scoreCandidatePairs is not part of the suite
+    numThreads = 1;
+
+    vector<BenchmarkInstance> instances;
+    for (const char* path : paths) instances.push_back(readInstance(path));
+    if (instances.empty()) {
+        instances.push_back(generateSparse(5000, 15000));
+        instances.push_back(generateDense(400, 0.5));
+        instances.push_back(generatePowerLaw(5000, 20000, 2.5));
+        instances.push_back(generateGrid(70, 70));
+    }
+
+    cout << "c seed " << seed << ", " << reps << " runs per primitive after one warm-up, times in ns per operation\n";
+    cout << left << setw(12) << "graph" << setw(26) << "primitive" << right << setw(9) << "ops"
+         << setw(14) << "mean" << setw(12) << "stddev" << setw(14) << "min" << setw(14) << "median" << "\n";
+    for (const BenchmarkInstance& instance : instances) benchmarkInstance(instance);
+    return 0;
+}
@@ -11,13 +11,24 @@
 #include <iomanip> 
 #include <unordered_dense.h>
 #include <queue>
+#include <numeric>
+#include <thread>
 #include "BoostGraph.hpp"
+#include "BitsetAdjacency.hpp"
+#include "CsrAdjacency.hpp"
+#include "GrReader.hpp"
+#include "Random.hpp"
+#include "Telemetry.hpp"
+#include "TwinClasses.hpp"
+#include "WorkStealingScheduler.hpp"
 
 using namespace std;
 using namespace std::chrono;
 
 const auto TIME_LIMIT = std::chrono::seconds(300);
 const int SCORE_RESET_THRESHOLD = 50000000;
+int numThreads = max(1, (int)thread::hardware_concurrency()); // components solved at once, needs -pthread
+bool twinReduction = true; // contract twin classes of every component before the heuristic
 
 struct PairHash {
     size_t operator()(const pair<int, int>& p) const {
@@ -69,12 +80,17 @@ private:
     std::map<int, ankerl::unordered_dense::set<int>> degreeToVertices;
     bool useRedDegreeMap = true;
     bool useDegreeMap = true;
+    BitsetAdjacency neighborBits; // mirrors black + red edges while bitsetScores is set
+    ankerl::unordered_dense::map<int, int> bitsetRows; // vertex -> row in neighborBits
+    bool bitsetScores = false;
     int width = 0;
+    bool printProgress = true; // per-iteration "c" lines, off while components are solved concurrently
+    Xoshiro256 gen; // random walks draw from the graph, not the thread, so a component's run does not depend on scheduling
 
 public:
     Graph() {}
 
-    Graph(const Graph &g) {
+    Graph(const Graph &g) : gen(12345) {
         this->vertices = g.vertices;
         this->adjListBlack = g.adjListBlack;
         this->adjListRed = g.adjListRed;
@@ -82,7 +98,43 @@ public:
         this->degreeToVertices = g.degreeToVertices;
         this->useDegreeMap = g.useDegreeMap;
         this->useRedDegreeMap = g.useRedDegreeMap;
+        this->neighborBits = g.neighborBits;
+        this->bitsetRows = g.bitsetRows;
+        this->bitsetScores = g.bitsetScores && this->neighborBits.allocated();
         this->width = g.width;
+        this->printProgress = g.printProgress;
+    }
+
+    void setPrintProgress(bool enabled) {
+        printProgress = enabled;
+    }
+
+    void reseed(unsigned seed) {
+        gen.seed(seed);
+    }
+
+    // Switches getScore to XOR + popcount over a dense matrix, skipped for graphs that do not fit
+    // or when the process-wide BitsetAdjacency budget is used up
+    void enableBitsetScores() {
+        bitsetScores = neighborBits.allocate(vertices.size());
+        if (!bitsetScores) return;
+        bitsetRows.clear();
+        for (int v : vertices) {
+            bitsetRows.emplace(v, bitsetRows.size());
+        }
+        for (const auto& [v, neighbors] : adjListBlack) {
+            for (int neighbor : neighbors) neighborBits.addEdge(bitsetRows[v], bitsetRows[neighbor]);
+        }
+        for (const auto& [v, neighbors] : adjListRed) {
+            for (int neighbor : neighbors) neighborBits.addEdge(bitsetRows[v], bitsetRows[neighbor]);
+        }
+    }
+
+    // Hands the matrix back to the budget once the graph no longer needs scores
+    void disableBitsetScores() {
+        bitsetScores = false;
+        bitsetRows.clear();
+        neighborBits.release();
     }
 
     void addVertex(int v){
@@ -109,6 +161,7 @@ public:
             adjListRed[v1].insert(v2);
             adjListRed[v2].insert(v1);
         }    
+        if (bitsetScores) neighborBits.addEdge(bitsetRows[v1], bitsetRows[v2]);
     }
 
     void removeEdge(int v1, int v2) {
@@ -125,6 +178,12 @@ public:
             updateVertexRedDegree(v2, -1);
             adjListRed[v1].erase(v2);
             adjListRed[v2].erase(v1);
+        } else {
+            return;
+        }
+        // a pair can be black and red at once in the middle of mergeVertices
+        if (bitsetScores && adjListRed[v1].find(v2) == adjListRed[v1].end()) {
+            neighborBits.removeEdge(bitsetRows[v1], bitsetRows[v2]);
         }
     }
 
@@ -223,49 +282,64 @@ public:
         return componentGraphs;
     }
 
-    ostringstream findTwins() {
-        ostringstream contractionSequence;        
-        set<int> vertices_set(vertices.begin(), vertices.end());
-        
-        set<set<int>> partitions; 
-        set<set<int>> updated_partitions; 
-        partitions.insert(vertices_set);
-
+    // Contracts every class of false twins (trueTwins: true twins) into its smallest vertex.
+    // Twins have equal black neighbourhoods, so none of these merges creates a red edge;
+    // vertices that already have red edges are left out.
+    ostringstream findTwins(bool trueTwins) {
+        ostringstream contractionSequence;
+        static const ankerl::unordered_dense::set<int> noNeighbors;
+        auto neighbors = [&](int v) -> const ankerl::unordered_dense::set<int>& {
+            auto it = adjListBlack.find(v);
+            return it == adjListBlack.end() ? noNeighbors : it->second;
+        };
+        vector<int> candidates;
         for (int v : vertices) {
-            ankerl::unordered_dense::set<int> neighbors = adjListBlack[v];
-            std::set<int> neighbors_set(neighbors.begin(), neighbors.end());
-            neighbors_set.insert(v);
-            for (set partition : partitions) {
-                std::set<int> difference;
-                std::set_difference(partition.begin(), partition.end(), neighbors_set.begin(), neighbors_set.end(), 
-                        std::inserter(difference, difference.end()));
-
-                std::set<int> intersection;
-                std::set_intersection(partition.begin(), partition.end(), neighbors_set.begin(), neighbors_set.end(), 
-                        std::inserter(intersection, intersection.end()));
-
-                if (!difference.empty()) updated_partitions.insert(difference);
-                if (!intersection.empty()) updated_partitions.insert(intersection);
-            }
-            partitions = updated_partitions;
-            updated_partitions.clear();
-        }
-        for (const set<int>& partition : partitions) {
-            if (partition.size() > 1) {
-                auto it = partition.begin();
-                int first = *it;
-                ++it;
-                while(it != partition.end()) {
-                    int next = *it;
-                    contractionSequence << first + 1 << " " << next + 1 << "\n";
-                    mergeVertices(first, next); 
-                    ++it;
-                }
+            auto red = adjListRed.find(v);
+            if (red == adjListRed.end() || red->second.empty()) candidates.push_back(v);
+        }
+        sort(candidates.begin(), candidates.end());
+        vector<vector<int>> classes = TwinClasses::find(candidates, neighbors,
+            [&](int u, int v) { return neighbors(u).contains(v); }, trueTwins);
+        for (const vector<int>& members : classes) {
+            for (size_t k = 1; k < members.size(); k++) {
+                contractionSequence << members[0] + 1 << " " << members[k] + 1 << "\n";
+                mergeVertices(members[0], members[k]);
             }
         }
         return contractionSequence;
     }
 
+    // False and true twins alternately until neither finds any, see TwinClasses::reduce
+    ostringstream reduceTwins() {
+        ostringstream contractionSequence;
+        TwinClasses::reduce([&](bool trueTwins) {
+            string twins = findTwins(trueTwins).str();
+            contractionSequence << twins;
+            return !twins.empty();
+        }, [&] { return vertices.size() > 1; });
+        return contractionSequence;
+    }
+
+    // Contracts one-degree vertices with the same neighbour into the first of them, grouped
+    // by neighbour in one pass; oneDegreeList keeps the vertices that are left. Such leaves
+    // never raise the width, and none of the merges changes the degree of another leaf.
+    void contractOneDegreeTwins(vector<int>& oneDegreeList, ostringstream& contractionSequence) {
+        ankerl::unordered_dense::map<int, int> leafOf;
+        vector<int> remaining;
+        for (int vertex : oneDegreeList) {
+            int neighbor = adjListBlack[vertex].empty() ? *begin(adjListRed[vertex]) : *begin(adjListBlack[vertex]);
+            auto [it, inserted] = leafOf.try_emplace(neighbor, vertex);
+            if (inserted) {
+                remaining.push_back(vertex);
+                continue;
+            }
+            contractionSequence << it->second + 1 << " " << vertex + 1 << "\n"; // Adjusting to 1-based index
+            mergeVertices(it->second, vertex);
+            if (printProgress) cout << "c One degree twins eliminated:" << it->second + 1 << " " << vertex + 1 << "\n";
+        }
+        oneDegreeList.swap(remaining);
+    }
+
     // Randomly all with others if those are one degree at the time of initial graph state
     ostringstream applyOneDegreeRuleInititalState() {
         ostringstream contractionSequence;
@@ -301,9 +375,9 @@ public:
         auto duration = duration_cast<milliseconds>(stop - start);
         int seconds_part = duration.count() / 1000;
         int milliseconds_part = duration.count() % 1000;
-        std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+        if (printProgress && telemetry.progressDue()) std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
         << std::setfill('0') << std::setw(9) << milliseconds_part 
-        << " seconds" << std::endl;
+        << " seconds" << "\n";
 
         return contractionSequence;
     }
@@ -322,22 +396,7 @@ public:
         std::mt19937 g(rd());
         int count = 0;
 
-        for (size_t i = 0; i < oneDegreeList.size() - 1; ++i) {
-            int n1;
-            if (adjListBlack[oneDegreeList[i]].size() == 1) n1 = *begin(adjListBlack[oneDegreeList[i]]);
-            else if (adjListRed[oneDegreeList[i]].size() == 1) n1 = *begin(adjListRed[oneDegreeList[i]]);
-            for (size_t j = i+1; j < oneDegreeList.size(); ++j) {
-                int n2;
-                if (adjListBlack[oneDegreeList[j]].size() == 1) n2 = *begin(adjListBlack[oneDegreeList[j]]);
-                else if (adjListRed[oneDegreeList[j]].size() == 1) n2 = *begin(adjListRed[oneDegreeList[j]]);
-                if (n1 == n2) {
-                    contractionSequence << oneDegreeList[i] + 1 << " " << oneDegreeList[j] + 1 << "\n"; // Adjusting to 1-based index
-                    mergeVertices(oneDegreeList[i], oneDegreeList[j]); // Assuming mergeVertices returns the resulting vertex
-                    oneDegreeList.erase(oneDegreeList.begin() + j);
-                    cout << "c One degree twins eliminated:" << oneDegreeList[i] + 1 << " " << oneDegreeList[j] + 1 << "\n";
-                }
-            }
-        }
+        contractOneDegreeTwins(oneDegreeList, contractionSequence);
 
         auto start = high_resolution_clock::now();
 
@@ -359,9 +418,9 @@ public:
         auto duration = duration_cast<milliseconds>(stop - start);
         int seconds_part = duration.count() / 1000;
         int milliseconds_part = duration.count() % 1000;
-        std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+        if (printProgress && telemetry.progressDue()) std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
         << std::setfill('0') << std::setw(9) << milliseconds_part 
-        << " seconds" << std::endl;
+        << " seconds" << "\n";
 
         return contractionSequence;
     }
@@ -380,31 +439,16 @@ public:
         std::mt19937 g(rd());
         int count = 0;
 
-        for (size_t i = 0; i < oneDegreeList.size() - 1; ++i) {
-            int n1;
-            if (adjListBlack[oneDegreeList[i]].size() == 1) n1 = *begin(adjListBlack[oneDegreeList[i]]);
-            else if (adjListRed[oneDegreeList[i]].size() == 1) n1 = *begin(adjListRed[oneDegreeList[i]]);
-            for (size_t j = i+1; j < oneDegreeList.size(); ++j) {
-                int n2;
-                if (adjListBlack[oneDegreeList[j]].size() == 1) n2 = *begin(adjListBlack[oneDegreeList[j]]);
-                else if (adjListRed[oneDegreeList[j]].size() == 1) n2 = *begin(adjListRed[oneDegreeList[j]]);
-                if (n1 == n2) {
-                    contractionSequence << oneDegreeList[i] + 1 << " " << oneDegreeList[j] + 1 << "\n"; // Adjusting to 1-based index
-                    mergeVertices(oneDegreeList[i], oneDegreeList[j]); // Assuming mergeVertices returns the resulting vertex
-                    oneDegreeList.erase(oneDegreeList.begin() + j);
-                    cout << "c One degree twins eliminated:" << oneDegreeList[i] + 1 << " " << oneDegreeList[j] + 1 << "\n";
-                }
-            }
-        }
+        contractOneDegreeTwins(oneDegreeList, contractionSequence);
 
         auto start = high_resolution_clock::now();
         auto stop = high_resolution_clock::now();
         auto duration = duration_cast<milliseconds>(stop - start);
         int seconds_part = duration.count() / 1000;
         int milliseconds_part = duration.count() % 1000;
-        std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+        if (printProgress && telemetry.progressDue()) std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
         << std::setfill('0') << std::setw(9) << milliseconds_part 
-        << " seconds" << std::endl;
+        << " seconds" << "\n";
 
         return contractionSequence;
     }
@@ -420,22 +464,7 @@ public:
         std::vector<int> filteredOneDegreeList;
 
         std::vector<int> oneDegreeList(oneDegreeVertices.begin(), oneDegreeVertices.end());
-        for (size_t i = 0; i < oneDegreeList.size() - 1; ++i) {
-            int n1;
-            if (adjListBlack[oneDegreeList[i]].size() == 1) n1 = *begin(adjListBlack[oneDegreeList[i]]);
-            else if (adjListRed[oneDegreeList[i]].size() == 1) n1 = *begin(adjListRed[oneDegreeList[i]]);
-            for (size_t j = i+1; j < oneDegreeList.size(); ++j) {
-                int n2;
-                if (adjListBlack[oneDegreeList[j]].size() == 1) n2 = *begin(adjListBlack[oneDegreeList[j]]);
-                else if (adjListRed[oneDegreeList[j]].size() == 1) n2 = *begin(adjListRed[oneDegreeList[j]]);
-                if (n1 == n2) {
-                    contractionSequence << oneDegreeList[i] + 1 << " " << oneDegreeList[j] + 1 << "\n"; // Adjusting to 1-based index
-                    mergeVertices(oneDegreeList[i], oneDegreeList[j]); // Assuming mergeVertices returns the resulting vertex
-                    oneDegreeList.erase(oneDegreeList.begin() + j);
-                    cout << "c One degree twins eliminated:" << oneDegreeList[i] + 1 << " " << oneDegreeList[j] + 1 << "\n";
-                }
-            }
-        }
+        contractOneDegreeTwins(oneDegreeList, contractionSequence);
 
         int totalDegreeOfNeighbors = 0;
         for (int vertex : oneDegreeList) {
@@ -476,9 +505,9 @@ public:
         auto duration = duration_cast<milliseconds>(stop - start);
         int seconds_part = duration.count() / 1000;
         int milliseconds_part = duration.count() % 1000;
-        std::cout << "c (Merged " << count << ", tww: " << width << ") Cycle in " << seconds_part << "." 
+        if (printProgress && telemetry.progressDue()) std::cout << "c (Merged " << count << ", tww: " << width << ") Cycle in " << seconds_part << "." 
         << std::setfill('0') << std::setw(9) << milliseconds_part 
-        << " seconds" << std::endl;
+        << " seconds" << "\n";
 
         return contractionSequence;
     }
@@ -512,9 +541,9 @@ public:
         auto duration = duration_cast<milliseconds>(stop - start);
         int seconds_part = duration.count() / 1000;
         int milliseconds_part = duration.count() % 1000;
-        std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+        if (printProgress && telemetry.progressDue()) std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
         << std::setfill('0') << std::setw(9) << milliseconds_part 
-        << " seconds" << std::endl;
+        << " seconds" << "\n";
 
         return contractionSequence;
     }
@@ -534,22 +563,7 @@ public:
         int count = 0;
 
         auto start = high_resolution_clock::now();
-        for (size_t i = 0; i < oneDegreeList.size() - 1; ++i) {
-            int n1;
-            if (adjListBlack[oneDegreeList[i]].size() == 1) n1 = *begin(adjListBlack[oneDegreeList[i]]);
-            else if (adjListRed[oneDegreeList[i]].size() == 1) n1 = *begin(adjListRed[oneDegreeList[i]]);
-            for (size_t j = i+1; j < oneDegreeList.size(); ++j) {
-                int n2;
-                if (adjListBlack[oneDegreeList[j]].size() == 1) n2 = *begin(adjListBlack[oneDegreeList[j]]);
-                else if (adjListRed[oneDegreeList[j]].size() == 1) n2 = *begin(adjListRed[oneDegreeList[j]]);
-                if (n1 == n2) {
-                    contractionSequence << oneDegreeList[i] + 1 << " " << oneDegreeList[j] + 1 << "\n"; // Adjusting to 1-based index
-                    mergeVertices(oneDegreeList[i], oneDegreeList[j]); // Assuming mergeVertices returns the resulting vertex
-                    oneDegreeList.erase(oneDegreeList.begin() + j);
-                    cout << "c One degree twins eliminated:" << oneDegreeList[i] + 1 << " " << oneDegreeList[j] + 1 << "\n";
-                }
-            }
-        }
+        contractOneDegreeTwins(oneDegreeList, contractionSequence);
 
         // Shuffle the list to achieve randomness
         std::shuffle(oneDegreeList.begin(), oneDegreeList.end(), g);
@@ -565,9 +579,9 @@ public:
         auto duration = duration_cast<milliseconds>(stop - start);
         int seconds_part = duration.count() / 1000;
         int milliseconds_part = duration.count() % 1000;
-        std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+        if (printProgress && telemetry.progressDue()) std::cout << "c (Merged " << count << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
         << std::setfill('0') << std::setw(9) << milliseconds_part 
-        << " seconds" << std::endl;
+        << " seconds" << "\n";
 
         return contractionSequence;
     }
@@ -595,42 +609,31 @@ public:
             neighbors.end(),
             std::back_inserter(randomNeighbors),
             neighborsNumber,
-            std::mt19937{std::random_device{}()}
+            gen
         );
         randomNeighbors.erase(std::remove(randomNeighbors.begin(), randomNeighbors.end(), vertex), randomNeighbors.end());
         return randomNeighbors;
     } 
 
     int getRandomDistance() {
-        static std::random_device rd; 
-        static std::mt19937 gen(rd()); 
-        std::uniform_int_distribution<> distrib(1, 2);
-
-        return distrib(gen);
+        return 1 + gen.below(2);
     }
 
+    // Uniform over black and red neighbours together: one index into both sets
     int getRandomNeighbor(int vertex) {
-        if (adjListBlack[vertex].empty() && !adjListRed[vertex].empty()) return getRandomSetElement(adjListRed[vertex]);
-        else if (!adjListBlack[vertex].empty() && adjListRed[vertex].empty()) return getRandomSetElement(adjListBlack[vertex]);
-        else {
-            int useRed = getRandomDistance();
-            if (useRed == 1) return getRandomSetElement(adjListRed[vertex]);
-            else return getRandomSetElement(adjListBlack[vertex]);
+        auto& black = adjListBlack[vertex];
+        auto& red = adjListRed[vertex];
+        if (black.empty() && red.empty()) {
+            throw std::runtime_error("Vertex has no neighbours");
         }
+        std::uint32_t i = gen.below(black.size() + red.size());
+        if (i < black.size()) return getSetElement(black, i);
+        return getSetElement(red, i - black.size());
     }
 
-    int getRandomSetElement(ankerl::unordered_dense::set<int>& s) {
-        if (s.empty()) {
-            throw std::runtime_error("Set is empty");
-        }
-        
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dist(0, s.size() - 1);
-
-        auto it = s.begin();
-        std::advance(it, dist(gen));
-        return *it;
+    // unordered_dense keeps its elements in one vector, so this is an index, not a walk
+    static int getSetElement(const ankerl::unordered_dense::set<int>& s, std::size_t index) {
+        return s.values()[index];
     }
 
     set<int> getRandomWalkVertices(int vertex, int numberVertices) {
@@ -638,7 +641,6 @@ public:
         for (int i = 0; i < numberVertices; ++i) {
             int distance = getRandomDistance();
             // int distance = 1;
-            cout << "c dist: " << distance << endl;
             
             int randomVertex = getRandomNeighbor(vertex);
             if (distance == 2 && adjListBlack[randomVertex].size() + adjListRed[randomVertex].size() != 0) randomVertex = getRandomNeighbor(randomVertex);
@@ -814,13 +816,15 @@ public:
     }
 
     void mergeVertices(int source, int twin){
-        auto start = high_resolution_clock::now();
+        auto start = steady_clock::now();
         removeEdge(source, twin);
         transferRedEdges(twin, source);
         markUniqueEdgesRed(source, twin);
         addNewRedNeighbors(source, twin);
         removeVertex(twin);
         updateWidth();
+        telemetry.count(Telemetry::MERGES);
+        telemetry.record(Telemetry::MERGE_NS, Telemetry::nanosecondsSince(start));
         // auto stop = high_resolution_clock::now();
         // auto duration = duration_cast<milliseconds>(stop - start);
         // int seconds_part = duration.count() / 1000;
@@ -1006,6 +1010,8 @@ public:
     }
 
     int getScore(int v1, int v2) {
+        if (bitsetScores) return neighborBits.symmetricDifference(bitsetRows[v1], bitsetRows[v2]);
+
         ankerl::unordered_dense::set<int> neighbors_v1_temp = adjListBlack[v1];
         if (adjListRed.find(v1) != adjListRed.end()) {
             neighbors_v1_temp.insert(adjListRed[v1].begin(), adjListRed[v1].end());
@@ -1153,8 +1159,7 @@ public:
             }
 
             contractionSequence << bestPair.first + 1 << " " << bestPair.second + 1 << "\n";
-            if (!areInTwoNeighborhood(bestPair.first, bestPair.second)) cout << "c Not neighbors, score: " << bestScore << endl;
-            else cout << "c Neighbors, score: " << bestScore << endl;
+            if (printProgress) cout << (areInTwoNeighborhood(bestPair.first, bestPair.second) ? "c Neighbors" : "c Not neighbors") << ", score: " << bestScore << "\n";
             mergeVertices(bestPair.first, bestPair.second);
 
             if (++iterationCounter >= SCORE_RESET_THRESHOLD) {
@@ -1172,9 +1177,9 @@ public:
             auto duration = duration_cast<milliseconds>(stop - start);
             int seconds_part = duration.count() / 1000;
             int milliseconds_part = duration.count() % 1000;
-            std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
             << std::setfill('0') << std::setw(9) << milliseconds_part 
-            << " seconds" << std::endl;
+            << " seconds" << "\n";
         }
         return contractionSequence;
     }
@@ -1222,8 +1227,7 @@ public:
 
             contractionSequence << bestPair.first + 1 << " " << bestPair.second + 1 << "\n";
 
-            if (!areInTwoNeighborhood(bestPair.first, bestPair.second)) cout << "c Not neighbors, score: " << bestScore << endl;
-            else cout << "c Neighbors, score: " << bestScore << endl;
+            if (printProgress) cout << (areInTwoNeighborhood(bestPair.first, bestPair.second) ? "c Neighbors" : "c Not neighbors") << ", score: " << bestScore << "\n";
 
             mergeVertices(bestPair.first, bestPair.second);
 
@@ -1242,9 +1246,9 @@ public:
             auto duration = duration_cast<milliseconds>(stop - start);
             int seconds_part = duration.count() / 1000;
             int milliseconds_part = duration.count() % 1000;
-            std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
             << std::setfill('0') << std::setw(9) << milliseconds_part 
-            << " seconds" << std::endl;
+            << " seconds" << "\n";
         }
         return contractionSequence;
     }
@@ -1332,9 +1336,9 @@ public:
             auto duration = duration_cast<milliseconds>(stop - start);
             int seconds_part = duration.count() / 1000;
             int milliseconds_part = duration.count() % 1000;
-            std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Left " << vertices.size() << ", tww: " << getWidth() << ") Cycle in " << seconds_part << "." 
             << std::setfill('0') << std::setw(9) << milliseconds_part 
-            << " seconds" << std::endl;
+            << " seconds" << "\n";
         }
         return contractionSequence;
     }
@@ -1453,9 +1457,9 @@ public:
             auto duration = duration_cast<milliseconds>(stop - start);
             int seconds_part = duration.count() / 1000;
             int milliseconds_part = duration.count() % 1000;
-            std::cout << "c (Left " << vertices.size() << ") Cycle in " << seconds_part << "." 
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Left " << vertices.size() << ") Cycle in " << seconds_part << "." 
             << std::setfill('0') << std::setw(9) << milliseconds_part 
-            << " seconds" << std::endl;
+            << " seconds" << "\n";
         }
         return contractionSequence;
     }
@@ -1533,9 +1537,9 @@ public:
             auto duration = duration_cast<milliseconds>(stop - start);
             int seconds_part = duration.count() / 1000;
             int milliseconds_part = duration.count() % 1000;
-            std::cout << "c (Left " << vertices.size() << ") Cycle in " << seconds_part << "." 
+            if (printProgress && telemetry.progressDue()) std::cout << "c (Left " << vertices.size() << ") Cycle in " << seconds_part << "." 
             << std::setfill('0') << std::setw(9) << milliseconds_part 
-            << " seconds" << std::endl;
+            << " seconds" << "\n";
         }
         return contractionSequence;
     }
@@ -1567,74 +1571,72 @@ string getLastLine(ostringstream& oss) {
     }
 }
 
-int main() {
+// Usage: solver [instance.gr], reads stdin when no file is given
+int main(int argc, char* argv[]) {
     Graph g;
     BoostGraph boostGraph;
-    string line;
     int numVertices, numEdges;
-    set<pair<int, int>> readEdges;
     bool constructComplement = false;
 
     auto start = high_resolution_clock::now(); 
 
-    while (getline(cin, line)) {
-        if (line[0] == 'c') {
-            continue;
-        }
-
-        vector<string> tokens;
-        string token;
-        std::stringstream tokenStream(line);
-        while (tokenStream >> token) {
-            tokens.push_back(token);
-        }
-
-        if (tokens[0] == "p") {
-            numVertices = stoi(tokens[2]);
-            numEdges = stoi(tokens[3]);
-            g.addVertices(numVertices);
-            boostGraph = BoostGraph(numVertices);
+    GrInstance instance = GrReader::read(argc > 1 ? argv[1] : nullptr);
+    numVertices = instance.numVertices;
+    numEdges = instance.numEdges;
+    g.addVertices(numVertices);
+    boostGraph = BoostGraph(numVertices);
 
-            double density = (2.0 * numEdges) / (numVertices * (numVertices - 1));
-            if (density > 0.5) {
-                constructComplement = true;
-            }
-        } else if (constructComplement) {
-            int u = stoi(tokens[0]);
-            int v = stoi(tokens[1]);
-            readEdges.insert({min(u-1, v-1), max(u-1, v-1)});
-        } else {
-            int u = stoi(tokens[0]);
-            int v = stoi(tokens[1]);
-            g.addEdge(u - 1, v - 1, "black");
-            boostGraph.addEdge(u - 1, v - 1);
-        }
+    // As a double: numVertices * (numVertices - 1) overflows int above 46341 vertices
+    double density = numVertices < 2 ? 0 : (2.0 * numEdges) / (double(numVertices) * (numVertices - 1));
+    if (density > 0.5) {
+        constructComplement = true;
     }
-
     if (constructComplement) {
+        CsrAdjacency complement = CsrAdjacency::fromEdges(numVertices, instance.edges).complement(numThreads);
         for (int i = 0; i < numVertices; i++) {
-            for (int j = i + 1; j < numVertices; j++) {
-                if (readEdges.find({i, j}) == readEdges.end()) {
+            for (int k = complement.offsets[i]; k < complement.offsets[i + 1]; k++) {
+                int j = complement.targets[k];
+                if (j > i) {
                     g.addEdge(i, j, "black");
                     boostGraph.addEdge(i, j);
                 }
             }
         }
     }
+    else {
+        for (const auto& [u, v] : instance.edges) {
+            g.addEdge(u, v, "black");
+            boostGraph.addEdge(u, v);
+        }
+    }
+    instance = GrInstance();
 
     auto stop = high_resolution_clock::now();
     auto duration = duration_cast<seconds>(stop - start);
     std::cout << "c Time taken too initialize the graph: " << duration.count() << " seconds" << std::endl;
 
     std::vector<Graph> components = g.findConnectedComponents();
-    std::vector<int> remainingVertices;
-    for (Graph& c : components) {
+    // Components are contracted concurrently, largest first, each into its own buffer;
+    // the buffers and the final joins are written in the original component order
+    vector<ostringstream> componentContractions(components.size());
+    std::vector<int> remainingVertices(components.size());
+    vector<int> order(components.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return components[a].getVertices().size() > components[b].getVertices().size();
+    });
+    bool concurrent = numThreads > 1 && components.size() > 1;
+
+    WorkStealingScheduler scheduler(numThreads);
+    scheduler.run(order, [&](int index) {
+        Graph& c = components[index];
+        c.reseed(12345 + index); // by component, whichever worker picks it up
+        ostringstream& componentContraction = componentContractions[index];
+        if (concurrent) c.setPrintProgress(false);
         std::vector<int> partition1;
         std::vector<int> partition2;
-        ostringstream componentContraction;
 
-        // ostringstream twins = c.findTwins();
-        // cout << twins.str();
+        if (twinReduction) componentContraction << c.reduceTwins().str();
         // cout << c.applyOneDegreeRule().str();
 
         // if (c.isBipartiteBoost(partition1, partition2)) {
@@ -1644,10 +1646,11 @@ int main() {
         // else componentContraction = c.findRedDegreeContraction();
         // cout << componentContraction.str();
 
-        cout << c.findRedDegreeContractionRandomWalk().str();
+        c.enableBitsetScores();
+        componentContraction << c.findRedDegreeContractionRandomWalk().str();
+        c.disableBitsetScores(); // contracted, only the ids are needed
         if (c.getVertices().size() == 1){
-            int remainingVertex = *c.getVertices().begin() + 1;
-            remainingVertices.push_back(remainingVertex);
+            remainingVertices[index] = *c.getVertices().begin() + 1;
         }
         else {
             // Extract here the last remaining vertex from the findRedDegreeContraction's output and push it back to remaining vertices
@@ -1655,8 +1658,12 @@ int main() {
             stringstream lastPair(lastLine);
             int remainingVertex;
             lastPair >> remainingVertex;
-            remainingVertices.push_back(remainingVertex);
+            remainingVertices[index] = remainingVertex;
         }
+    });
+
+    for (ostringstream& componentContraction : componentContractions) {
+        cout << componentContraction.str();
     }
 
     int primaryVertex = remainingVertices[0];
@@ -1669,6 +1676,7 @@ int main() {
     auto final_stop = high_resolution_clock::now();
     auto final_duration = duration_cast<seconds>(final_stop - start);
     std::cout << "c In total: " << final_duration.count() << " seconds" << std::endl;
+    telemetry.writeSummary(cerr);
 
     return 0;    
 }
\ No newline at end of file
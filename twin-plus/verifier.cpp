@@ -0,0 +1,76 @@
+// Checks a contraction sequence against a .gr instance with Verifier (the solver's own Graph
+// merge), in place of scripts/verifier.py. The sequence is streamed: it is read in blocks and
+// every pair is merged as soon as its line is complete, so the verifier can sit at the end of
+// a pipe. Malformed or illegal pairs are reported with their line and skipped, the sequence
+// then counts as invalid. Prints "Width: w" like verifier.py for a valid sequence, exit code 0
+// if and only if the sequence is valid.
+//
+// Usage: verifier instance.gr [sequence]   (the sequence is read from stdin if omitted)
+// Build: g++ -std=c++20 -O2 -pthread verifier.cpp -o verifier
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "GrReader.hpp"
+#include "Verifier.hpp"
+
+using namespace std;
+
+// Splits the stream into lines and feeds them to the verifier, a line may span several blocks
+void readSequence(int fd, Verifier& verifier) {
+    const size_t BLOCK_SIZE = size_t(1) << 20;
+    vector<char> buffer(BLOCK_SIZE);
+    string partial;
+    ssize_t got;
+    while ((got = ::read(fd, buffer.data(), BLOCK_SIZE)) > 0) {
+        const char* p = buffer.data();
+        const char* end = p + got;
+        while (p < end) {
+            const char* lineEnd = find(p, end, '\n');
+            if (lineEnd == end) {
+                partial.append(p, end);
+                break;
+            }
+            if (partial.empty()) {
+                verifier.addLine(p, lineEnd);
+            } else {
+                partial.append(p, lineEnd);
+                verifier.addLine(partial.data(), partial.data() + partial.size());
+                partial.clear();
+            }
+            p = lineEnd + 1;
+        }
+    }
+    if (!partial.empty()) verifier.addLine(partial.data(), partial.data() + partial.size());
+}
+
+int report(const Verifier& verifier) {
+    for (const string& message : verifier.messages()) cout << "c Malformed pair at " << message << "\n";
+    long long unreported = verifier.errors() - (long long)verifier.messages().size();
+    if (unreported > 0) cout << "c ... " << unreported << " more malformed pairs\n";
+    bool contracted = verifier.remaining() <= 1;
+    if (!contracted) cout << "c The graph was not completely contracted, " << verifier.remaining() << " vertices left\n";
+    cout << "c Steps: " << verifier.steps() << ", max red degree " << verifier.width();
+    if (verifier.widthStep() > 0) cout << " first reached at step " << verifier.widthStep() << " (line " << verifier.widthLine() << ")";
+    cout << "\n";
+    if (!verifier.complete()) {
+        cout << "Invalid sequence: " << verifier.errors() << " malformed pairs" << endl;
+        return 1;
+    }
+    cout << "Width: " << verifier.width() << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: verifier instance.gr [sequence]" << endl;
+        return 2;
+    }
+    int fd = 0;
+    if (argc > 2 && (fd = ::open(argv[2], O_RDONLY)) < 0) {
+        cerr << "Cannot open " << argv[2] << endl;
+        return 2;
+    }
+    Verifier verifier(GrReader::read(argv[1]));
+    readSequence(fd, verifier);
+    return report(verifier);
+}